@@ -143,6 +143,9 @@ static constexpr int minHeight     = 285;
 static constexpr int maxWidth      = 880;
 static constexpr int maxHeight     = 760;
 
+// CPU readout refresh rate; the peak is held for this many ticks
+static constexpr int cpuMeterHz    = 10;
+
 //==============================================================================
 // Constructor
 //==============================================================================
@@ -178,11 +181,26 @@ WarmSaturationEditor::WarmSaturationEditor (WarmSaturationProcessor& p)
     getConstrainer()->setFixedAspectRatio (static_cast<double> (defaultWidth)
                                            / static_cast<double> (defaultHeight));
 
+    cpuLabel.setText ("CPU --", juce::dontSendNotification);
+    cpuLabel.setJustificationType (juce::Justification::centred);
+    cpuLabel.setColour (juce::Label::textColourId, Theme::textDim);
+    addAndMakeVisible (cpuLabel);
+
     setSize (defaultWidth, defaultHeight);
+
+    // Timing costs a clock read per stage, so it only runs while the meter
+    // is on screen. Whatever is left over from a previous editor is stale.
+    WarmSaturationProcessor::BlockTiming stale;
+    while (processorRef.popBlockTiming (stale)) {}
+
+    processorRef.setTimingEnabled (true);
+    startTimerHz (cpuMeterHz);
 }
 
 WarmSaturationEditor::~WarmSaturationEditor()
 {
+    stopTimer();
+    processorRef.setTimingEnabled (false);
     setLookAndFeel (nullptr);
 }
 
@@ -200,6 +218,93 @@ void WarmSaturationEditor::setupKnob (juce::Slider& knob, juce::Label& label,
     addAndMakeVisible (label);
 }
 
+//==============================================================================
+// CPU readout — share of the real-time budget this instance uses, i.e. time
+// spent in processBlock() over the audio duration of the block. The average
+// is smoothed across ticks; the peak is the worst single block, held for a
+// second. Both leave out the blocks that also timed their stages, since the
+// extra clock reads slow those down; those blocks give the per-stage split
+// in the tooltip instead.
+//==============================================================================
+void WarmSaturationEditor::timerCallback()
+{
+    using Saturation = TubeSaturation<float>;
+
+    WarmSaturationProcessor::BlockTiming timing;
+    std::array<double, Saturation::numStages> stageSeconds {};
+    double busySeconds = 0.0, audioSeconds = 0.0, blockPeak = 0.0, stagedBusySeconds = 0.0;
+
+    while (processorRef.popBlockTiming (timing))
+    {
+        if (timing.numSamples <= 0 || timing.sampleRate <= 0.0)
+            continue;
+
+        const double busy = juce::Time::highResolutionTicksToSeconds (timing.totalTicks);
+
+        if (timing.stagesTimed)
+        {
+            stagedBusySeconds += busy;
+
+            for (size_t stage = 0; stage < stageSeconds.size(); ++stage)
+                stageSeconds[stage] += juce::Time::highResolutionTicksToSeconds (timing.stageTicks[stage]);
+
+            continue;
+        }
+
+        const double available = timing.numSamples / timing.sampleRate;
+
+        busySeconds += busy;
+        audioSeconds += available;
+        blockPeak = juce::jmax (blockPeak, busy / available);
+    }
+
+    if (stagedBusySeconds > 0.0)
+    {
+        static constexpr const char* stageNames[Saturation::numStages] = { "GAIN", "SHAPER", "TILT", "MIX" };
+
+        auto share = [&] (double seconds) { return juce::String (100.0 * seconds / stagedBusySeconds, 0) + "%"; };
+
+        size_t heaviest = 0;
+        juce::String breakdown;
+        double staged = 0.0;
+
+        for (size_t stage = 0; stage < stageSeconds.size(); ++stage)
+        {
+            if (stageSeconds[stage] > stageSeconds[heaviest])
+                heaviest = stage;
+
+            breakdown << stageNames[stage] << " " << share (stageSeconds[stage]) << "\n";
+            staged += stageSeconds[stage];
+        }
+
+        breakdown << "OTHER " << share (juce::jmax (0.0, stagedBusySeconds - staged));
+
+        // The host sent more than it announced; each such block is split,
+        // which costs more than the same audio in announced-size blocks
+        if (const auto oversized = processorRef.getOversizedBlockCount(); oversized > 0)
+            breakdown << "\nOVERSIZED BLOCKS " << static_cast<int> (oversized);
+
+        heaviestStage = juce::String (stageNames[heaviest]) + " " + share (stageSeconds[heaviest]);
+        cpuLabel.setTooltip (breakdown);
+    }
+
+    // No blocks since the last tick (transport stopped): keep the reading
+    if (audioSeconds <= 0.0)
+        return;
+
+    averageLoad += 0.3 * (busySeconds / audioSeconds - averageLoad);
+
+    if (blockPeak >= peakLoad || ++peakAge >= cpuMeterHz)
+    {
+        peakLoad = blockPeak;
+        peakAge = 0;
+    }
+
+    cpuLabel.setText ("CPU " + juce::String (100.0 * averageLoad, 1) + "%  PEAK "
+                          + juce::String (100.0 * peakLoad, 1) + "%  " + heaviestStage,
+                      juce::dontSendNotification);
+}
+
 //==============================================================================
 // Procedural wood texture generator — dark walnut with vertical grain
 //==============================================================================
@@ -454,4 +559,8 @@ void WarmSaturationEditor::resized()
 
         kl.label.setBounds (cx - colW / 2, botRowY - labelH, colW, labelH);
     }
+
+    // === CPU readout: just above the footer ===
+    cpuLabel.setBounds (panelX, static_cast<int> (H * 0.9f), panelW, textBoxH);
+    cpuLabel.setFont (juce::FontOptions (static_cast<float> (H) * 0.025f));
 }
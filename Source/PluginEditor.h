@@ -18,7 +18,8 @@ public:
 };
 
 //==============================================================================
-class WarmSaturationEditor : public juce::AudioProcessorEditor
+class WarmSaturationEditor : public juce::AudioProcessorEditor,
+                             private juce::Timer
 {
 public:
     explicit WarmSaturationEditor (WarmSaturationProcessor&);
@@ -49,6 +50,14 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> outputAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mixAttachment;
 
+    // CPU readout, fed by the processor's block timings
+    juce::Label cpuLabel;
+    juce::TooltipWindow tooltipWindow { this, 400 };
+    double averageLoad = 0.0;
+    double peakLoad = 0.0;
+    int peakAge = 0;
+    juce::String heaviestStage;
+
     // Resizer
     std::unique_ptr<juce::ResizableCornerComponent> cornerResizer;
     juce::ComponentBoundsConstrainer constrainer;
@@ -60,6 +69,7 @@ private:
     void setupKnob (juce::Slider& knob, juce::Label& label, const juce::String& text);
     void generateWoodTexture (int width, int height);
     void generatePanelTexture (int width, int height);
+    void timerCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WarmSaturationEditor)
 };
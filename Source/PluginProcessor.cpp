@@ -8,9 +8,35 @@ WarmSaturationProcessor::WarmSaturationProcessor()
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
       apvts (*this, nullptr, "Parameters", createParameterLayout())
 {
+    for (size_t i = 0; i < numParameters; ++i)
+    {
+        rawParameters[i] = apvts.getRawParameterValue (parameterIDs[i]);
+        apvts.addParameterListener (parameterIDs[i], this);
+    }
+
+    parameterSnapshot.publish (rawParameters);
+
+    // Pins the float kernels to one instruction set for A/B comparisons,
+    // e.g. WARMSAT_KERNEL_TIER=avx2; unset or unknown means the widest
+    const auto tierName = juce::SystemStats::getEnvironmentVariable ("WARMSAT_KERNEL_TIER", {});
+    saturation.setKernelTier (SaturationKernels::getTierFromName (tierName.toRawUTF8()));
+
+    startTimerHz (10);
+}
+
+WarmSaturationProcessor::~WarmSaturationProcessor()
+{
+    stopTimer();
+
+    for (auto* id : parameterIDs)
+        apvts.removeParameterListener (id, this);
 }
 
-WarmSaturationProcessor::~WarmSaturationProcessor() {}
+// Called on whichever thread changed the value, host automation included
+void WarmSaturationProcessor::parameterChanged (const juce::String&, float)
+{
+    parameterSnapshot.publish (rawParameters);
+}
 
 //==============================================================================
 juce::AudioProcessorValueTreeState::ParameterLayout
@@ -66,6 +92,33 @@ WarmSaturationProcessor::createParameterLayout()
         },
         nullptr));
 
+    // Oversampling around the shaper: trades CPU for less aliasing
+    params.push_back (std::make_unique<juce::AudioParameterChoice> (
+        juce::ParameterID { "oversampling", 1 },
+        "Oversampling",
+        juce::StringArray { "1x", "2x", "4x", "8x", "16x" },
+        0));
+
+    params.push_back (std::make_unique<juce::AudioParameterChoice> (
+        juce::ParameterID { "osfilter", 1 },
+        "Oversampling Filter",
+        juce::StringArray { "Polyphase IIR", "Linear Phase FIR" },
+        0));
+
+    // On surround beds, pass the LFE channel through unsaturated
+    params.push_back (std::make_unique<juce::AudioParameterBool> (
+        juce::ParameterID { "excludelfe", 1 },
+        "Exclude LFE",
+        false));
+
+    // Real-time shaper, in the order of shaperModes; offline renders always
+    // use the exact curve
+    params.push_back (std::make_unique<juce::AudioParameterChoice> (
+        juce::ParameterID { "shaper", 1 },
+        "Shaper",
+        juce::StringArray { "Rational", "Lookup Table", "ADAA 1st Order", "ADAA 2nd Order" },
+        0));
+
     return { params.begin(), params.end() };
 }
 
@@ -77,18 +130,59 @@ void WarmSaturationProcessor::prepareToPlay (double sampleRate, int samplesPerBl
     spec.maximumBlockSize = static_cast<juce::uint32> (samplesPerBlock);
     spec.numChannels      = static_cast<juce::uint32> (getTotalNumOutputChannels());
 
-    saturation.prepare (spec);
+    // -1 on layouts without an LFE channel
+    lfeChannel = getChannelLayoutOfBus (false, 0).getChannelIndexForType (juce::AudioChannelSet::LFE);
+
+    // Push every value again after a re-prepare
+    snapshotVersion = ParameterSnapshot::invalidVersion;
+    appliedParameters.fill (std::numeric_limits<float>::quiet_NaN());
+
+    // The render tier is picked here and nowhere else. Hosts flag an
+    // offline render before preparing for it, and latency reported from
+    // here reaches them before the render starts; switching mid-stream
+    // would swap the oversampler with a click and report the new latency
+    // only at the next timer tick, possibly after the bounce has begun.
+    // A host that changes the flag without re-preparing keeps the tier it
+    // prepared with.
+    renderQuality = isNonRealtime();
+
+    if (isUsingDoublePrecision())
+    {
+        applyQualityTier (saturationDouble);
+        updateParameters (saturationDouble);
+        saturationDouble.prepare (spec);
+        engineLatency.store (saturationDouble.getLatencySamples(), std::memory_order_relaxed);
+    }
+    else
+    {
+        applyQualityTier (saturation);
+        updateParameters (saturation);
+        saturation.prepare (spec);
+        engineLatency.store (saturation.getLatencySamples(), std::memory_order_relaxed);
+    }
+
+    // Not on the audio thread here, so the host hears about it right away
+    updateHostLatency();
 }
 
 void WarmSaturationProcessor::releaseResources()
 {
     saturation.reset();
+    saturationDouble.reset();
 }
 
 bool WarmSaturationProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Mono and stereo, plus surround and immersive beds so a whole bed can
+    // run through one instance with its channels filtered side by side
+    const auto output = layouts.getMainOutputChannelSet();
+
+    if (output != juce::AudioChannelSet::mono()
+        && output != juce::AudioChannelSet::stereo()
+        && output != juce::AudioChannelSet::createLCR()
+        && output != juce::AudioChannelSet::create5point1()
+        && output != juce::AudioChannelSet::create7point1()
+        && output != juce::AudioChannelSet::create7point1point4())
         return false;
 
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
@@ -99,29 +193,163 @@ bool WarmSaturationProcessor::isBusesLayoutSupported (const BusesLayout& layouts
 
 void WarmSaturationProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                                              juce::MidiBuffer& /*midiMessages*/)
+{
+    processSamples (buffer, saturation);
+}
+
+// 64-bit hosts hand us their native buffers, so the double engine saves
+// them a conversion round-trip per instance
+void WarmSaturationProcessor::processBlock (juce::AudioBuffer<double>& buffer,
+                                             juce::MidiBuffer& /*midiMessages*/)
+{
+    processSamples (buffer, saturationDouble);
+}
+
+bool WarmSaturationProcessor::supportsDoublePrecisionProcessing() const { return true; }
+
+template <typename SampleType>
+void WarmSaturationProcessor::processSamples (juce::AudioBuffer<SampleType>& buffer,
+                                              TubeSaturation<SampleType>& engine)
 {
     juce::ScopedNoDenormals noDenormals;
 
+    const bool timing = timingEnabled.load (std::memory_order_relaxed);
+    const bool timeStages = timing && timedBlocks++ % stageSampleInterval == 0;
+    const auto startTicks = timing ? juce::Time::getHighResolutionTicks() : 0;
+    engine.setStageTimingEnabled (timeStages);
+
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // Read parameter values
-    float driveVal  = apvts.getRawParameterValue ("drive")->load();
-    float outputVal = apvts.getRawParameterValue ("output")->load();
-    float mixVal    = apvts.getRawParameterValue ("mix")->load() / 100.0f;
-    float toneVal   = apvts.getRawParameterValue ("tone")->load() / 100.0f;  // Map to -1..+1
-
-    // Update DSP parameters
-    saturation.setDrive (driveVal);
-    saturation.setOutput (outputVal);
-    saturation.setMix (mixVal);
-    saturation.setTone (toneVal);
+    updateParameters (engine);
 
     // Process audio
-    saturation.process (buffer);
+    engine.process (buffer);
+
+    // An oversampling change lands once its oversampler is built, which may
+    // be some blocks after the parameter moved, so this is read every block
+    engineLatency.store (engine.getLatencySamples(), std::memory_order_relaxed);
+
+    if (timing)
+        timingQueue.push ({ juce::Time::getHighResolutionTicks() - startTicks, engine.getStageTicks(),
+                            timeStages, buffer.getNumSamples(), getSampleRate() });
+}
+
+// With no new snapshot this is a single atomic load. Otherwise only values
+// that moved reach the DSP, so the dB-to-gain and filter coefficient maths
+// is skipped for static settings.
+template <typename SampleType>
+void WarmSaturationProcessor::updateParameters (TubeSaturation<SampleType>& engine)
+{
+    ParameterValues values;
+
+    if (! parameterSnapshot.readIfChanged (values, snapshotVersion))
+        return;
+
+    const auto changed = [&] (ParameterIndex index) { return ! juce::exactlyEqual (values[index], appliedParameters[index]); };
+
+    if (changed (driveIndex))
+        engine.setDrive (values[driveIndex]);
+
+    if (changed (outputIndex))
+        engine.setOutput (values[outputIndex]);
+
+    if (changed (mixIndex))
+        engine.setMix (values[mixIndex] / 100.0f);
+
+    if (changed (toneIndex))
+        engine.setTone (values[toneIndex] / 100.0f);  // Map to -1..+1
+
+    const bool oversamplingChanged = changed (oversamplingIndex) || changed (osFilterIndex);
+    const bool excludeLfeChanged = changed (excludeLfeIndex);
+    const bool shaperChanged = changed (shaperIndex);
+
+    appliedParameters = values;
+
+    // Both can move the latency; applyQualityTier() covers oversampling too
+    if (shaperChanged)
+        applyQualityTier (engine);
+    else if (oversamplingChanged)
+        updateOversampling (engine);
+
+    if (excludeLfeChanged)
+        engine.setPassthroughChannel (values[excludeLfeIndex] >= 0.5f ? lfeChannel : -1);
+}
+
+// Offline renders have CPU to spare, so they run the reference transfer
+// function at the highest oversampling factor; real-time playback uses the
+// shaper and the oversampling the user picked.
+template <typename SampleType>
+void WarmSaturationProcessor::applyQualityTier (TubeSaturation<SampleType>& engine)
+{
+    // Before the first snapshot has been read, updateParameters() sets it up
+    if (std::isnan (appliedParameters[shaperIndex]))
+    {
+        engine.setShaperMode (renderQuality ? TubeShaperMode::exact : TubeShaperMode::rational);
+        return;
+    }
+
+    constexpr TubeShaperMode shaperModes[] = { TubeShaperMode::rational, TubeShaperMode::table,
+                                               TubeShaperMode::adaa1, TubeShaperMode::adaa2 };
+
+    const auto choice = juce::jlimit (0, static_cast<int> (std::size (shaperModes)) - 1,
+                                      static_cast<int> (appliedParameters[shaperIndex]));
+
+    engine.setShaperMode (renderQuality ? TubeShaperMode::exact : shaperModes[choice]);
+    updateOversampling (engine);
+}
+
+template <typename SampleType>
+void WarmSaturationProcessor::updateOversampling (TubeSaturation<SampleType>& engine)
+{
+    const int order = renderQuality ? TubeSaturation<SampleType>::maxOversamplingOrder
+                                    : static_cast<int> (appliedParameters[oversamplingIndex]);
+    const auto filter = appliedParameters[osFilterIndex] < 0.5f
+                          ? TubeOversamplingFilter::polyphaseIIR
+                          : TubeOversamplingFilter::halfBandFIR;
+
+    engine.setOversampling (order, filter);
+}
+
+void WarmSaturationProcessor::updateHostLatency()
+{
+    // Lets the host re-align this track
+    const int latency = engineLatency.load (std::memory_order_relaxed);
+
+    if (latency != getLatencySamples())
+        setLatencySamples (latency);
+}
+
+void WarmSaturationProcessor::buildRequestedOversamplers()
+{
+    if (isUsingDoublePrecision())
+        saturationDouble.buildRequestedOversampler();
+    else
+        saturation.buildRequestedOversampler();
+}
+
+void WarmSaturationProcessor::timerCallback()
+{
+    buildRequestedOversamplers();
+    updateHostLatency();
+}
+
+juce::uint32 WarmSaturationProcessor::getOversizedBlockCount() const
+{
+    return saturation.getOversizedBlockCount() + saturationDouble.getOversizedBlockCount();
+}
+
+void WarmSaturationProcessor::setTimingEnabled (bool shouldTime)
+{
+    timingEnabled.store (shouldTime, std::memory_order_relaxed);
+}
+
+bool WarmSaturationProcessor::popBlockTiming (BlockTiming& dest)
+{
+    return timingQueue.pop (dest);
 }
 
 //==============================================================================
@@ -137,7 +365,11 @@ const juce::String WarmSaturationProcessor::getName() const { return JucePlugin_
 bool WarmSaturationProcessor::acceptsMidi() const { return false; }
 bool WarmSaturationProcessor::producesMidi() const { return false; }
 bool WarmSaturationProcessor::isMidiEffect() const { return false; }
-double WarmSaturationProcessor::getTailLengthSeconds() const { return 0.0; }
+double WarmSaturationProcessor::getTailLengthSeconds() const
+{
+    return isUsingDoublePrecision() ? saturationDouble.getTailLengthSeconds()
+                                    : saturation.getTailLengthSeconds();
+}
 
 //==============================================================================
 int WarmSaturationProcessor::getNumPrograms() { return 1; }
@@ -4,7 +4,9 @@
 #include "SaturationDSP.h"
 
 //==============================================================================
-class WarmSaturationProcessor : public juce::AudioProcessor
+class WarmSaturationProcessor : public juce::AudioProcessor,
+                                private juce::AudioProcessorValueTreeState::Listener,
+                                private juce::Timer
 {
 public:
     WarmSaturationProcessor();
@@ -17,6 +19,8 @@ public:
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==========================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -40,13 +44,227 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
+    //==========================================================================
+    // Blocks the host delivered larger than announced in prepareToPlay()
+    juce::uint32 getOversizedBlockCount() const;
+
+    // Message thread: tells the host about a latency the audio thread has
+    // moved to (an oversampling or shaper change). setLatencySamples()
+    // locks and calls into the host, so the audio thread only records the
+    // value and a timer reports it from here.
+    void updateHostLatency();
+
+    // Message thread: builds an oversampler the audio thread has been asked
+    // to switch to but doesn't have yet (see
+    // TubeSaturation::setOversampling()). Runs from the same timer.
+    void buildRequestedOversamplers();
+
+    //==========================================================================
+    // Cost of one processBlock() call, in juce::Time high-resolution ticks.
+    // Every block has its total; one in stageSampleInterval also has the
+    // cost of each engine stage, which takes extra clock reads and so makes
+    // that block slower than the rest. The stages don't add up to the
+    // total; the rest is parameter updates, ramps and bookkeeping.
+    struct BlockTiming
+    {
+        juce::int64 totalTicks = 0;
+        TubeSaturation<float>::StageTicks stageTicks {};
+        bool stagesTimed = false;
+        int numSamples = 0;
+        double sampleRate = 0;
+    };
+
+    static constexpr juce::uint32 stageSampleInterval = 16;
+
+    // Off by default. While on, every block pushes a BlockTiming for one
+    // consumer (the editor) to pop; anything it leaves unread for too long
+    // is dropped, never waited for.
+    void setTimingEnabled (bool shouldTime);
+    bool popBlockTiming (BlockTiming& dest);
+
     //==========================================================================
     juce::AudioProcessorValueTreeState apvts;
 
 private:
+    //==========================================================================
+    // Every parameter the DSP reads, in the order of parameterIDs
+    enum ParameterIndex
+    {
+        driveIndex,
+        outputIndex,
+        mixIndex,
+        toneIndex,
+        oversamplingIndex,
+        osFilterIndex,
+        excludeLfeIndex,
+        shaperIndex,
+        numParameters
+    };
+
+    static constexpr const char* parameterIDs[numParameters] =
+        { "drive", "output", "mix", "tone", "oversampling", "osfilter", "excludelfe", "shaper" };
+
+    using ParameterValues = std::array<float, numParameters>;
+
+    //==========================================================================
+    // All parameter values in one cache line, published as a unit through a
+    // seqlock: the version is odd while a write is in progress and moves on
+    // by two with every publish. Any thread that changes a parameter may
+    // publish; concurrent writers never wait for each other, the one holding
+    // the write flag simply publishes again on behalf of the others. The
+    // audio thread never waits either: its common case is a single acquire
+    // load of an unchanged version.
+    class ParameterSnapshot
+    {
+    public:
+        // The pending and writing flags are handed over with sequentially
+        // consistent operations: each side stores one flag and then loads
+        // the other, and only seq_cst orders such a store before the later
+        // load. With release/acquire a writer could see the flag still held
+        // and leave, while the holder reads the stale pending == false it
+        // stored itself, and the last change would never be published.
+        //
+        // The holder clears pending with an exchange, not a store: being a
+        // read-modify-write it reads the latest pending = true, and so
+        // synchronises with the writer that set it. That writer's parameter
+        // store is then visible to the reads of source[i] that follow; with
+        // a plain store a weakly ordered CPU could publish the old value,
+        // and the writer, having left, would never publish it again.
+        void publish (const std::array<std::atomic<float>*, numParameters>& source) noexcept
+        {
+            pending.store (true, std::memory_order_seq_cst);
+
+            while (pending.load (std::memory_order_seq_cst))
+            {
+                if (writing.exchange (true, std::memory_order_seq_cst))
+                    return;
+
+                pending.exchange (false, std::memory_order_seq_cst);
+
+                const auto v = version.load (std::memory_order_relaxed);
+                version.store (v + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence (std::memory_order_release);
+
+                for (size_t i = 0; i < numParameters; ++i)
+                    values[i].store (source[i]->load (std::memory_order_relaxed), std::memory_order_relaxed);
+
+                version.store (v + 2, std::memory_order_release);
+                writing.store (false, std::memory_order_seq_cst);
+            }
+        }
+
+        // Copies the snapshot into `dest` if its version differs from
+        // `lastVersion`. A write in progress is left for the next block.
+        bool readIfChanged (ParameterValues& dest, juce::uint32& lastVersion) const noexcept
+        {
+            const auto v = version.load (std::memory_order_acquire);
+
+            if (v == lastVersion || (v & 1) != 0)
+                return false;
+
+            for (size_t i = 0; i < numParameters; ++i)
+                dest[i] = values[i].load (std::memory_order_relaxed);
+
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            if (version.load (std::memory_order_relaxed) != v)
+                return false;
+
+            lastVersion = v;
+            return true;
+        }
+
+        // A version the snapshot never settles on, to force the next read
+        static constexpr juce::uint32 invalidVersion = 1;
+
+    private:
+        alignas (64) std::array<std::atomic<float>, numParameters> values {};
+        std::atomic<juce::uint32> version { 0 };
+        std::atomic<bool> writing { false }, pending { false };
+    };
+
+    //==========================================================================
+    // Single-producer, single-consumer ring of block timings: the audio
+    // thread pushes, the editor's timer pops. Each side writes only its own
+    // index, so neither ever waits; when the ring is full the new entry is
+    // dropped. The indices run freely and wrap through the power-of-two
+    // capacity.
+    class TimingQueue
+    {
+    public:
+        bool push (const BlockTiming& timing) noexcept
+        {
+            const auto w = writeIndex.load (std::memory_order_relaxed);
+
+            if (w - readIndex.load (std::memory_order_acquire) == capacity)
+                return false;
+
+            entries[w & (capacity - 1)] = timing;
+            writeIndex.store (w + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop (BlockTiming& dest) noexcept
+        {
+            const auto r = readIndex.load (std::memory_order_relaxed);
+
+            if (r == writeIndex.load (std::memory_order_acquire))
+                return false;
+
+            dest = entries[r & (capacity - 1)];
+            readIndex.store (r + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        // About 14 KB. A 10 Hz reader keeps up with blocks down to about
+        // 20 samples at 48 kHz, or 80 at 192 kHz; below that some blocks
+        // go unreported, which thins the statistics but doesn't skew them.
+        static constexpr juce::uint32 capacity = 256;
+
+        std::array<BlockTiming, capacity> entries {};
+        alignas (64) std::atomic<juce::uint32> writeIndex { 0 };
+        alignas (64) std::atomic<juce::uint32> readIndex { 0 };
+    };
+
+    void parameterChanged (const juce::String& parameterID, float newValue) override;
+    void timerCallback() override;
+
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    TubeSaturation saturation;
+    template <typename SampleType>
+    void processSamples (juce::AudioBuffer<SampleType>&, TubeSaturation<SampleType>&);
+
+    template <typename SampleType>
+    void updateParameters (TubeSaturation<SampleType>&);
+
+    template <typename SampleType>
+    void updateOversampling (TubeSaturation<SampleType>&);
+
+    template <typename SampleType>
+    void applyQualityTier (TubeSaturation<SampleType>&);
+
+    std::array<std::atomic<float>*, numParameters> rawParameters {};
+    ParameterSnapshot parameterSnapshot;
+
+    // Audio thread only: the snapshot last seen and the values last pushed
+    juce::uint32 snapshotVersion = ParameterSnapshot::invalidVersion;
+    ParameterValues appliedParameters {};
+
+    int lfeChannel = -1;
+    bool renderQuality = false;  // offline tier active
+
+    // Latency of the running engine, written on the audio thread
+    std::atomic<int> engineLatency { 0 };
+
+    std::atomic<bool> timingEnabled { false };
+    juce::uint32 timedBlocks = 0;  // audio thread only
+    TimingQueue timingQueue;
+
+    // One engine per processing precision; only the one matching
+    // isUsingDoublePrecision() is prepared and run
+    TubeSaturation<float> saturation;
+    TubeSaturation<double> saturationDouble;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WarmSaturationProcessor)
 };
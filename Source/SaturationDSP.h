@@ -2,6 +2,202 @@
 
 #include <JuceHeader.h>
 #include <cmath>
+#include <map>
+
+#include "SaturationKernels.h"
+
+//==============================================================================
+// SIMD helpers
+//
+// juce::dsp::SIMDRegister covers add/multiply/min/max but has no division,
+// which the rational tanh approximation below needs. Use the native divide
+// where JUCE maps the register onto a hardware vector, and fall back to a
+// per-lane loop everywhere else (e.g. doubles on NEON).
+//==============================================================================
+namespace SIMDHelpers
+{
+    template <typename SampleType>
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
+    template <typename SampleType>
+    inline Vec<SampleType> JUCE_VECTOR_CALLTYPE divide (Vec<SampleType> num, Vec<SampleType> den) noexcept
+    {
+       #if JUCE_USE_SIMD && (defined (__i386__) || defined (__amd64__) || defined (_M_X64) || defined (_X86_) || defined (_M_IX86))
+        #if defined (__AVX2__)
+        if constexpr (std::is_same_v<SampleType, float>)
+            return Vec<SampleType>::fromNative (_mm256_div_ps (num.value, den.value));
+        else
+            return Vec<SampleType>::fromNative (_mm256_div_pd (num.value, den.value));
+        #else
+        if constexpr (std::is_same_v<SampleType, float>)
+            return Vec<SampleType>::fromNative (_mm_div_ps (num.value, den.value));
+        else
+            return Vec<SampleType>::fromNative (_mm_div_pd (num.value, den.value));
+        #endif
+       #elif JUCE_USE_SIMD && defined (__aarch64__)
+        if constexpr (std::is_same_v<SampleType, float>)
+            return Vec<SampleType>::fromNative (vdivq_f32 (num.value, den.value));
+       #endif
+
+        Vec<SampleType> result;
+        for (size_t i = 0; i < Vec<SampleType>::size(); ++i)
+            result.set (i, num.get (i) / den.get (i));
+        return result;
+    }
+}
+
+//==============================================================================
+// Parameter ramp
+//
+// A linear smoother for host parameters, in the spirit of juce::SmoothedValue,
+// but with the ramp length chosen per change. Hosts only hand us one value
+// per block, so a change seen at the start of a block is spread over that
+// block, clamped to the minimum and maximum ramp durations (5 and 10 ms by
+// default, 240 and 480 samples at 48 kHz).
+//
+// What holds at every buffer size is the duration of a ramp, not its shape
+// within a block. Only blocks between the two limits get exactly one ramp
+// per block, i.e. automation followed piecewise-linearly between block
+// boundaries. Smaller blocks spread a change over several blocks, since a
+// jump ramped over a few samples would click. A change that arrives
+// mid-ramp restarts it from the current value. Larger blocks finish the
+// ramp early and then hold, as no finer automation data reaches the plugin.
+//
+// setTargetValue() only records the new target; applyPendingTarget() starts
+// the ramp once the length of the block it belongs to is known.
+//==============================================================================
+template <typename SampleType>
+class ParameterRamp
+{
+public:
+    explicit ParameterRamp (SampleType initialValue = 0) noexcept
+        : current (initialValue), target (initialValue) {}
+
+    void reset (double sampleRate,
+                double minimumRampSeconds = defaultMinimumRampSeconds,
+                double maximumRampSeconds = defaultMaximumRampSeconds) noexcept
+    {
+        minimumRampSamples = juce::jmax (1, juce::roundToInt (sampleRate * minimumRampSeconds));
+        maximumRampSamples = juce::jmax (minimumRampSamples, juce::roundToInt (sampleRate * maximumRampSeconds));
+        setCurrentAndTargetValue (target);
+    }
+
+    void setCurrentAndTargetValue (SampleType newValue) noexcept
+    {
+        current = target = newValue;
+        countdown = 0;
+        pending = false;
+    }
+
+    void setTargetValue (SampleType newValue) noexcept
+    {
+        if (juce::exactlyEqual (newValue, target))
+            return;
+
+        target = newValue;
+        pending = true;
+    }
+
+    // Starts the ramp towards a target set since the last block
+    void applyPendingTarget (int blockLength) noexcept
+    {
+        if (! pending)
+            return;
+
+        pending = false;
+        countdown = juce::jlimit (minimumRampSamples, maximumRampSamples, blockLength);
+        step = (target - current) / static_cast<SampleType> (countdown);
+    }
+
+    bool isSmoothing() const noexcept { return pending || countdown > 0; }
+
+    SampleType getCurrentValue() const noexcept { return current; }
+    SampleType getTargetValue() const noexcept { return target; }
+
+    SampleType getNextValue() noexcept
+    {
+        jassert (! pending);  // applyPendingTarget() first
+
+        if (countdown <= 0)
+            return target;
+
+        if (--countdown == 0)
+            current = target;
+        else
+            current += step;
+
+        return current;
+    }
+
+    void skip (int numSamples) noexcept
+    {
+        jassert (! pending);
+
+        if (numSamples >= countdown)
+        {
+            current = target;
+            countdown = 0;
+        }
+        else
+        {
+            current += step * static_cast<SampleType> (numSamples);
+            countdown -= numSamples;
+        }
+    }
+
+    // The minimum keeps a jump from clicking at tiny buffer sizes; the
+    // maximum bounds the lag a change picks up on large blocks
+    static constexpr double defaultMinimumRampSeconds = 0.005;
+    static constexpr double defaultMaximumRampSeconds = 0.01;
+
+private:
+    SampleType current, target, step = 0;
+    int countdown = 0;
+    int minimumRampSamples = 1, maximumRampSamples = 1;
+    bool pending = false;
+};
+
+//==============================================================================
+// Process-wide table cache
+//
+// Read-only tables that depend only on a key (sample rate, table size...)
+// are built once and shared by every instance in the process. Hold one
+// through juce::SharedResourcePointer: the cache lives as long as any
+// instance does, and each table as long as any instance still uses it.
+// Building happens under the lock, so instances preparing together wait
+// for the first one instead of all building the same table.
+//
+// These tables are small next to the oversamplers, which can't be shared:
+// their stage buffers and filter state are per channel and per instance,
+// up to maxBlock x channels x factor samples each, and they are the bulk
+// of an instance's memory. TubeSaturation keeps that down by building only
+// the oversampler in use (see TubeSaturation::setOversampling()).
+//==============================================================================
+template <typename Key, typename Value>
+class SharedTableCache
+{
+public:
+    template <typename Builder>
+    std::shared_ptr<const Value> get (const Key& key, Builder&& build)
+    {
+        const juce::ScopedLock sl (lock);
+
+        if (auto existing = entries[key].lock())
+            return existing;
+
+        // Forget tables nobody holds any more before adding a new one
+        for (auto it = entries.begin(); it != entries.end();)
+            it = it->second.expired() ? entries.erase (it) : std::next (it);
+
+        auto table = std::make_shared<const Value> (build());
+        entries[key] = table;
+        return table;
+    }
+
+private:
+    juce::CriticalSection lock;
+    std::map<Key, std::weak_ptr<const Value>> entries;
+};
 
 //==============================================================================
 // Tilt EQ — single-knob tone shaping
@@ -17,208 +213,1776 @@
 // Implementation: first-order shelf using a biquad with coefficients
 // derived from the tilt amount and pivot frequency.
 //==============================================================================
+template <typename SampleType>
 class TiltEQ
 {
 public:
     TiltEQ() = default;
 
-    void prepare (double newSampleRate, int numChannels)
+    // Tilt positions sampled by the coefficient table, -1..+1 inclusive
+    static constexpr int coefficientTableSize = 201;
+
+    struct Coefficients
+    {
+        SampleType a0 = 1, a1 = 0, b1 = 0;
+    };
+
+    void prepare (double newSampleRate, int numChannels, int maximumBlockSize)
     {
         sampleRate = newSampleRate;
-        x1.resize (static_cast<size_t> (numChannels), 0.0f);
-        y1.resize (static_cast<size_t> (numChannels), 0.0f);
-        updateCoefficients();
+
+        // Filter state as one aligned struct-of-arrays block: x[n-1] for every
+        // channel, then y[n-1], each padded to whole SIMD registers
+        constexpr int width = static_cast<int> (Vec::size());
+        paddedChannels = ((numChannels + width - 1) / width) * width;
+        stateStorage.assign (static_cast<size_t> (2 * paddedChannels + width), SampleType());
+        x1 = Vec::getNextSIMDAlignedPtr (stateStorage.data());
+        y1 = x1 + paddedChannels;
+
+        // All pow/tan work happens here, once per sample rate per process
+        coefficientTable = coefficientCache->get (sampleRate, [rate = sampleRate]
+        {
+            std::vector<Coefficients> table (coefficientTableSize);
+            for (int i = 0; i < coefficientTableSize; ++i)
+                table[static_cast<size_t> (i)] = makeCoefficients (rate, tiltForIndex (i));
+            return table;
+        });
+
+        SampleType slowestPole = 0;
+        for (const auto& c : *coefficientTable)
+            slowestPole = juce::jmax (slowestPole, std::abs (c.b1));
+
+        decaySamples = slowestPole > 0
+                         ? static_cast<int> (std::ceil (std::log (std::numeric_limits<float>::min()) / std::log (slowestPole)))
+                         : 1;
+
+        a0Ramp.resize (static_cast<size_t> (maximumBlockSize));
+        a1Ramp.resize (static_cast<size_t> (maximumBlockSize));
+        b1Ramp.resize (static_cast<size_t> (maximumBlockSize));
+        filledLength = 0;
+        steady = false;
+
+        tilt.reset (sampleRate);
+
+        if (kernels == nullptr)
+            kernels = &SaturationKernels::getTable (SaturationKernels::Tier::automatic);
+    }
+
+    // Float builds run the multichannel recursion through these; the owner
+    // passes its own table so both follow the same tier
+    void setKernels (const SaturationKernels::Table& newKernels)
+    {
+        kernels = &newKernels;
     }
 
     void reset()
     {
-        std::fill (x1.begin(), x1.end(), 0.0f);
-        std::fill (y1.begin(), y1.end(), 0.0f);
+        std::fill (stateStorage.begin(), stateStorage.end(), SampleType());
+        tilt.setCurrentAndTargetValue (tilt.getTargetValue());
+        filledLength = 0;
+        steady = false;
     }
 
     // Set tilt amount: -1.0 (dark) to +1.0 (bright), 0.0 = flat
-    void setTilt (float newTilt)
+    void setTilt (SampleType newTilt)
+    {
+        tilt.setTargetValue (juce::jlimit (static_cast<SampleType> (-1), static_cast<SampleType> (1), newTilt));
+    }
+
+    // Starts the ramp to a tilt set since the last block, spread over the
+    // whole host block; beginBlock() does this itself if not called.
+    void applyPendingTarget (int blockLength)
     {
-        if (std::abs (newTilt - tilt) > 0.001f)
+        tilt.applyPendingTarget (blockLength);
+    }
+
+    // Expands this block's coefficients into per-sample ramps. While the
+    // tilt is moving each sample gets its own interpolated coefficients, so
+    // automation is free of zipper noise; once it settles the ramps hold
+    // the final values and are only rewritten if the block grows.
+    void beginBlock (int numSamples)
+    {
+        jassert (numSamples <= static_cast<int> (a0Ramp.size()));
+
+        // No-op if the owner already started the ramp for a longer host block
+        tilt.applyPendingTarget (numSamples);
+
+        if (tilt.isSmoothing())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                setRamp (i, lookupCoefficients (tilt.getNextValue()));
+
+            filledLength = 0;
+            steady = false;
+        }
+        else if (numSamples > filledLength)
         {
-            tilt = newTilt;
-            updateCoefficients();
+            const auto c = lookupCoefficients (tilt.getTargetValue());
+            juce::FloatVectorOperations::fill (a0Ramp.data(), c.a0, numSamples);
+            juce::FloatVectorOperations::fill (a1Ramp.data(), c.a1, numSamples);
+            juce::FloatVectorOperations::fill (b1Ramp.data(), c.b1, numSamples);
+            filledLength = numSamples;
+
+            if (! steady)
+                updateScanKernel (c);
+
+            steady = true;
         }
     }
 
-    float processSample (int channel, float input)
+    // `index` is the sample position within the block passed to beginBlock()
+    SampleType processSample (int channel, int index, SampleType input)
     {
-        const auto ch = static_cast<size_t> (channel);
-        float output = a0 * input + a1 * x1[ch] - b1 * y1[ch];
-        x1[ch] = input;
-        y1[ch] = output;
+        const auto n = static_cast<size_t> (index);
+        SampleType output = a0Ramp[n] * input + a1Ramp[n] * x1[channel] - b1Ramp[n] * y1[channel];
+        x1[channel] = input;
+        y1[channel] = output;
         return output;
     }
 
-private:
-    void updateCoefficients()
+    // Filters numSamples frames in place, starting at `startIndex` within the
+    // block passed to beginBlock(). Mono runs the scalar recursion; with more
+    // channels each frame is packed into SIMD registers so all channels of a
+    // register advance together and stereo costs about the same as mono.
+    void processBlock (SampleType* const* channelData, int numChannels, int startIndex, int numSamples)
+    {
+        if (numChannels == 1)
+        {
+            auto* data = channelData[0];
+
+            if (steady)
+            {
+                processScan (data, numSamples);
+                return;
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = processSample (0, startIndex + i, data[i]);
+
+            return;
+        }
+
+        processInterleaved (channelData, numChannels, startIndex, numSamples);
+    }
+
+    // Samples for the impulse response to fall from full scale to the smallest
+    // normal float at the slowest-decaying tilt setting (the pole is -b1)
+    int getDecaySamples() const
+    {
+        return decaySamples;
+    }
+
+    // Exact coefficients for a tilt position; uses pow/tan, keep off the audio thread
+    static Coefficients makeCoefficients (double sampleRate, SampleType tiltAmount)
     {
         // Pivot frequency ~800Hz
-        constexpr float pivotHz = 800.0f;
-        const float wc = 2.0f * juce::MathConstants<float>::pi * pivotHz
-                         / static_cast<float> (sampleRate);
+        constexpr SampleType pivotHz = 800;
+        const SampleType wc = 2 * juce::MathConstants<SampleType>::pi * pivotHz
+                         / static_cast<SampleType> (sampleRate);
 
         // Map tilt to gain: ±6dB range
-        const float gainDb = tilt * 6.0f;
-        const float gain = std::pow (10.0f, gainDb / 20.0f);
+        const SampleType gainDb = tiltAmount * 6;
+        const SampleType gain = std::pow (static_cast<SampleType> (10), gainDb / 20);
 
         // Compute first-order shelf coefficients
         // Using matched analog prototype: H(s) = (s + wc*g) / (s + wc/g)
         // Bilinear transform gives us the digital coefficients
-        const float g = gain;
-        const float tanW = std::tan (wc * 0.5f);
-        const float t = tanW / g;
+        const SampleType g = gain;
+        const SampleType tanW = std::tan (wc / 2);
+        const SampleType t = tanW / g;
+
+        Coefficients c;
+        c.a0 = (tanW * g + 1) / (t + 1);
+        c.a1 = (tanW * g - 1) / (t + 1);
+        c.b1 = (t - 1) / (t + 1);
+        return c;
+    }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
+    void processInterleaved (SampleType* const* channelData, int numChannels, int startIndex, int numSamples)
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            kernels->tiltInterleaved (channelData, numChannels, x1, y1,
+                                      a0Ramp.data() + startIndex, a1Ramp.data() + startIndex,
+                                      b1Ramp.data() + startIndex, numSamples);
+            return;
+        }
+
+        constexpr int width = static_cast<int> (Vec::size());
+
+        const SampleType* a0 = a0Ramp.data() + startIndex;
+        const SampleType* a1 = a1Ramp.data() + startIndex;
+        const SampleType* b1 = b1Ramp.data() + startIndex;
+
+        for (int first = 0; first < numChannels; first += width)
+        {
+            const int lanes = juce::jmin (width, numChannels - first);
+            SampleType* const* channels = channelData + first;
+
+            // Lanes past the last channel stay zero throughout, as in the
+            // float kernels; fed stale data, a bright tilt's recursion
+            // would run away in them
+            alignas (Vec::SIMDRegisterSize) SampleType in[width] = {}, out[width] = {}, state[width] = {};
+
+            std::copy (x1 + first, x1 + first + lanes, state);
+            auto xPrev = Vec::fromRawArray (state);
+
+            std::copy (y1 + first, y1 + first + lanes, state);
+            auto yPrev = Vec::fromRawArray (state);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                for (int lane = 0; lane < lanes; ++lane)
+                    in[lane] = channels[lane][i];
+
+                const auto input = Vec::fromRawArray (in);
+                const auto output = input * a0[i] + xPrev * a1[i] - yPrev * b1[i];
+                xPrev = input;
+                yPrev = output;
+
+                output.copyToRawArray (out);
+                for (int lane = 0; lane < lanes; ++lane)
+                    channels[lane][i] = out[lane];
+            }
+
+            xPrev.copyToRawArray (state);
+            std::copy (state, state + lanes, x1 + first);
+
+            yPrev.copyToRawArray (state);
+            std::copy (state, state + lanes, y1 + first);
+        }
+    }
+
+    //==========================================================================
+    // Block-parallel form of the mono recursion, for steady coefficients.
+    //
+    // With u[n] = a0 x[n] + a1 x[n-1] and c = -b1, the filter is the
+    // first-order scan y[n] = u[n] + c y[n-1]. Unrolled over one register of
+    // W samples starting at n:
+    //
+    //   y[n+k] = sum_{j<=k} c^(k-j) u[n+j] + c^(k+1) y[n-1]
+    //
+    // so each register is W broadcast multiply-adds against precomputed
+    // columns of powers of c, and only the carry y[n-1] is serial between
+    // registers. The FIR part is computed in place first, back to front.
+    // Only the summation order differs from processSample(); with |c| < 1
+    // the two agree to within a few ulps of the output.
+    //==========================================================================
+    void updateScanKernel (const Coefficients& c)
+    {
+        constexpr size_t width = Vec::size();
+        const SampleType pole = -c.b1;
+
+        SampleType power[width + 1];
+        power[0] = 1;
+        for (size_t k = 1; k <= width; ++k)
+            power[k] = power[k - 1] * pole;
+
+        for (size_t j = 0; j < width; ++j)
+            for (size_t k = 0; k < width; ++k)
+                scanColumns[j].set (k, k >= j ? power[k - j] : SampleType());
+
+        for (size_t k = 0; k < width; ++k)
+            scanCarry.set (k, power[k + 1]);
+
+        scanCoefficients = c;
+    }
+
+    void processScan (SampleType* data, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+
+        constexpr int width = static_cast<int> (Vec::size());
+        const SampleType a0 = scanCoefficients.a0;
+        const SampleType a1 = scanCoefficients.a1;
+        const SampleType pole = -scanCoefficients.b1;
+
+        // FIR part in place: u[i] = a0 x[i] + a1 x[i-1]
+        const SampleType lastInput = data[numSamples - 1];
+        for (int i = numSamples - 1; i > 0; --i)
+            data[i] = a0 * data[i] + a1 * data[i - 1];
+        data[0] = a0 * data[0] + a1 * x1[0];
+        x1[0] = lastInput;
+
+        // Recursive part, scalar up to the first aligned sample
+        SampleType y = y1[0];
+        const int head = juce::jmin (numSamples, static_cast<int> (Vec::getNextSIMDAlignedPtr (data) - data));
+        const int body = ((numSamples - head) / width) * width;
+
+        for (int i = 0; i < head; ++i)
+            data[i] = y = data[i] + pole * y;
+
+        for (int i = head; i < head + body; i += width)
+        {
+            auto out = scanCarry * y;
+            for (int j = 0; j < width; ++j)
+                out += scanColumns[static_cast<size_t> (j)] * data[i + j];
+
+            out.copyToRawArray (data + i);
+            y = data[i + width - 1];
+        }
+
+        for (int i = head + body; i < numSamples; ++i)
+            data[i] = y = data[i] + pole * y;
+
+        y1[0] = y;
+    }
+
+    static SampleType tiltForIndex (int index)
+    {
+        return -1 + 2 * static_cast<SampleType> (index) / static_cast<SampleType> (coefficientTableSize - 1);
+    }
+
+    // Linear interpolation between the two nearest table entries
+    Coefficients lookupCoefficients (SampleType tiltAmount) const
+    {
+        const SampleType position = (tiltAmount + 1) / 2 * static_cast<SampleType> (coefficientTableSize - 1);
+        const int i = juce::jlimit (0, coefficientTableSize - 2, static_cast<int> (position));
+        const SampleType frac = position - static_cast<SampleType> (i);
+
+        const auto& lo = (*coefficientTable)[static_cast<size_t> (i)];
+        const auto& hi = (*coefficientTable)[static_cast<size_t> (i + 1)];
 
-        a0 = (tanW * g + 1.0f) / (t + 1.0f);
-        a1 = (tanW * g - 1.0f) / (t + 1.0f);
-        b1 = (t - 1.0f) / (t + 1.0f);
+        return { lo.a0 + frac * (hi.a0 - lo.a0),
+                 lo.a1 + frac * (hi.a1 - lo.a1),
+                 lo.b1 + frac * (hi.b1 - lo.b1) };
+    }
+
+    void setRamp (int index, const Coefficients& c)
+    {
+        const auto n = static_cast<size_t> (index);
+        a0Ramp[n] = c.a0;
+        a1Ramp[n] = c.a1;
+        b1Ramp[n] = c.b1;
     }
 
     double sampleRate = 44100.0;
-    float tilt = 0.0f;
-    float a0 = 1.0f, a1 = 0.0f, b1 = 0.0f;
+    ParameterRamp<SampleType> tilt { 0 };
+    int decaySamples = 1;
+
+    // Shared by every TiltEQ at the same sample rate
+    juce::SharedResourcePointer<SharedTableCache<double, std::vector<Coefficients>>> coefficientCache;
+    std::shared_ptr<const std::vector<Coefficients>> coefficientTable;
+    std::vector<SampleType> a0Ramp, a1Ramp, b1Ramp;
+    int filledLength = 0;
+    bool steady = false;
 
-    std::vector<float> x1;  // x[n-1] per channel
-    std::vector<float> y1;  // y[n-1] per channel
+    std::array<Vec, Vec::SIMDNumElements> scanColumns {};
+    Vec scanCarry {};
+    Coefficients scanCoefficients;
+
+    std::vector<SampleType> stateStorage;
+    int paddedChannels = 0;
+    SampleType* x1 = nullptr;  // x[n-1] per channel, SIMD aligned
+    SampleType* y1 = nullptr;  // y[n-1] per channel, SIMD aligned
+
+    const SaturationKernels::Table* kernels = nullptr;
 };
 
 //==============================================================================
-// Tube-style saturation processor
+// Waveshaper lookup table
 //
-// Emulates the asymmetric soft-clipping behavior of vacuum tubes.
-// Real tubes clip positive and negative halves differently, generating
-// even-order harmonics (2nd, 4th...) which sound "warm" and "musical."
-// The squared term in the transfer function creates this asymmetry.
+// Samples a static transfer function on a uniform grid once, then reads it
+// back with linear or cubic (Catmull-Rom) interpolation — the same idea as
+// juce::dsp::LookupTableTransform, but with one guard point either side so
+// the cubic read never needs a branch at the edges, and with linear
+// extrapolation (continuing the end segment) outside the sampled range.
+//
+// Building the table allocates, so initialise() belongs in prepare().
 //==============================================================================
-class TubeSaturation
+template <typename SampleType>
+class WaveshaperTable
 {
 public:
-    TubeSaturation() = default;
+    enum class Interpolation
+    {
+        linear,
+        cubic
+    };
 
-    void prepare (const juce::dsp::ProcessSpec& spec)
+    // Error of the table against the function it was built from
+    struct Accuracy
     {
-        sampleRate = spec.sampleRate;
-        numChannels = static_cast<int> (spec.numChannels);
+        SampleType maxAbsError = 0;
+        SampleType rmsError = 0;
+        SampleType worstInput = 0;
+    };
 
-        // Pre-gain (drive)
-        preGain.prepare (spec);
-        preGain.setRampDurationSeconds (0.02);
+    WaveshaperTable() = default;
 
-        // Post-gain (output level)
-        postGain.prepare (spec);
-        postGain.setRampDurationSeconds (0.02);
+    void initialise (const std::function<SampleType (SampleType)>& function,
+                     SampleType minInput, SampleType maxInput, int numPoints)
+    {
+        jassert (maxInput > minInput && numPoints >= 4);
 
-        // Tilt EQ for tone shaping
-        tiltEQ.prepare (sampleRate, numChannels);
+        size = numPoints;
+        minX = minInput;
+        step = (maxInput - minInput) / static_cast<SampleType> (numPoints - 1);
+        invStep = 1 / step;
+        maxIndex = static_cast<SampleType> (numPoints - 1);
 
-        // Dry buffer for mix blending
-        dryBuffer.setSize (numChannels,
-                           static_cast<int> (spec.maximumBlockSize));
+        // points[0] and points[size + 1] are the guard points
+        points.resize (static_cast<size_t> (numPoints + 2));
+        for (int i = -1; i <= numPoints; ++i)
+            points[static_cast<size_t> (i + 1)] = function (minX + step * static_cast<SampleType> (i));
+
+        // Extrapolation slopes, per index step. Measured over a wide span:
+        // differencing two adjacent table points loses too many digits once
+        // the slope gets multiplied by a large overshoot.
+        const SampleType maxX = minX + step * maxIndex;
+        const SampleType span = (maxX - minX) / 64;
+        lowSlope  = (function (minX + span) - function (minX)) / span * step;
+        highSlope = (function (maxX) - function (maxX - span)) / span * step;
     }
 
-    void reset()
+    bool isInitialised() const { return size > 0; }
+    int getNumPoints() const { return size; }
+
+    SampleType processSample (SampleType x, Interpolation interpolation) const noexcept
     {
-        preGain.reset();
-        postGain.reset();
-        tiltEQ.reset();
+        const SampleType index = (x - minX) * invStep;
+        const SampleType clamped = juce::jlimit (SampleType(), maxIndex, index);
+        const SampleType overshoot = index - clamped;
+        const SampleType slope = index < 0 ? lowSlope : highSlope;
+
+        // Keep i one below the last point so i + 1 (and the guard at i + 2) exist
+        const int i = juce::jmin (static_cast<int> (clamped), size - 2);
+        const SampleType frac = clamped - static_cast<SampleType> (i);
+        const SampleType* p = points.data() + i + 1;
+
+        SampleType y;
+        if (interpolation == Interpolation::linear)
+        {
+            y = p[0] + frac * (p[1] - p[0]);
+        }
+        else
+        {
+            const SampleType c1 = (p[1] - p[-1]) / 2;
+            const SampleType c2 = p[-1] - static_cast<SampleType> (2.5) * p[0] + 2 * p[1] - p[2] / 2;
+            const SampleType c3 = (p[2] - p[-1]) / 2 + static_cast<SampleType> (1.5) * (p[0] - p[1]);
+            y = ((c3 * frac + c2) * frac + c1) * frac + p[0];
+        }
+
+        return y + overshoot * slope;
     }
 
-    // Set drive amount in dB (0 to 40)
-    void setDrive (float driveDb)
+    void processBlock (SampleType* data, int numSamples, Interpolation interpolation) const noexcept
     {
-        preGain.setGainDecibels (driveDb);
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = processSample (data[i], interpolation);
     }
 
-    // Set output level in dB (-24 to +6)
-    void setOutput (float outputDb)
+    // Compares the table to the reference over [minInput, maxInput], which may
+    // extend past the sampled range to include the extrapolated region.
+    Accuracy measureAccuracy (const std::function<SampleType (SampleType)>& reference,
+                              SampleType minInput, SampleType maxInput,
+                              Interpolation interpolation, int numTestPoints = 100000) const
     {
-        postGain.setGainDecibels (outputDb);
+        Accuracy result;
+        double sumSquares = 0.0;
+
+        for (int i = 0; i < numTestPoints; ++i)
+        {
+            const SampleType x = minInput + (maxInput - minInput) * static_cast<SampleType> (i)
+                                           / static_cast<SampleType> (numTestPoints - 1);
+            const SampleType error = std::abs (processSample (x, interpolation) - reference (x));
+            sumSquares += static_cast<double> (error) * error;
+
+            if (error > result.maxAbsError)
+            {
+                result.maxAbsError = error;
+                result.worstInput = x;
+            }
+        }
+
+        result.rmsError = static_cast<SampleType> (std::sqrt (sumSquares / numTestPoints));
+        return result;
     }
 
-    // Set dry/wet mix (0.0 to 1.0)
-    void setMix (float newMix)
+private:
+    std::vector<SampleType> points;
+    int size = 0;
+    SampleType minX = 0, step = 1, invStep = 1, maxIndex = 0;
+    SampleType lowSlope = 0, highSlope = 0;
+};
+
+//==============================================================================
+// Dry-path delay
+//
+// Keeps the dry signal time-aligned with a wet path that has latency (the
+// oversampling filters). Only the last `delay` input samples are stored per
+// channel; a block is delayed in place by rotating it and swapping its head
+// with that history, so no scratch buffer is needed.
+//==============================================================================
+template <typename SampleType>
+class DryDelay
+{
+public:
+    DryDelay() = default;
+
+    void prepare (int numChannels, int maxDelaySamples)
     {
-        mix = newMix;
+        history.setSize (numChannels, juce::jmax (1, maxDelaySamples));
+        history.clear();
+        delay = 0;
     }
 
-    // Set tone tilt: -1.0 (dark) to +1.0 (bright), 0.0 = neutral
-    void setTone (float toneValue)
+    void reset()
     {
-        tiltEQ.setTilt (toneValue);
+        history.clear();
     }
 
-    void process (juce::AudioBuffer<float>& buffer)
+    // Clamped to the prepared capacity; before prepare() this is 0, and the
+    // owner sets the delay again once prepared.
+    void setDelay (int newDelay)
     {
-        const int channels   = buffer.getNumChannels();
-        const int numSamples = buffer.getNumSamples();
+        newDelay = juce::jmin (newDelay, history.getNumSamples());
 
-        // Save dry signal for mix blending
-        for (int ch = 0; ch < channels; ++ch)
-            dryBuffer.copyFrom (ch, 0, buffer, ch, 0, numSamples);
+        if (newDelay != delay)
+        {
+            delay = newDelay;
+            history.clear();
+        }
+    }
 
-        // Wrap buffer in a dsp::AudioBlock
-        juce::dsp::AudioBlock<float> block (buffer);
-        juce::dsp::ProcessContextReplacing<float> context (block);
+    int getDelay() const { return delay; }
 
-        // Apply drive (pre-gain)
-        preGain.process (context);
+    // Feeds a block into the history without producing delayed output. Only
+    // the last `delay` samples are touched, so keeping the history current
+    // while the dry signal isn't needed costs next to nothing.
+    void advance (int channel, const SampleType* input, int numSamples)
+    {
+        if (delay == 0)
+            return;
 
-        // Apply tube-style waveshaping + tilt EQ per sample
-        for (int ch = 0; ch < channels; ++ch)
+        auto* h = history.getWritePointer (channel);
+
+        if (numSamples >= delay)
         {
-            auto* data = buffer.getWritePointer (ch);
-            for (int i = 0; i < numSamples; ++i)
-            {
-                data[i] = tubeWaveshape (data[i]);
-                data[i] = tiltEQ.processSample (ch, data[i]);
-            }
+            std::copy (input + numSamples - delay, input + numSamples, h);
+        }
+        else
+        {
+            std::copy (h + numSamples, h + delay, h);
+            std::copy (input, input + numSamples, h + delay - numSamples);
         }
+    }
 
-        // Apply output gain
-        juce::dsp::AudioBlock<float> outputBlock (buffer);
-        juce::dsp::ProcessContextReplacing<float> outputContext (outputBlock);
-        postGain.process (outputContext);
+    void process (int channel, SampleType* data, int numSamples)
+    {
+        if (delay == 0)
+            return;
 
-        // Dry/wet mix blending
-        if (mix < 1.0f)
-        {
-            for (int ch = 0; ch < channels; ++ch)
-            {
-                auto* wetData = buffer.getWritePointer (ch);
-                const auto* dryData = dryBuffer.getReadPointer (ch);
+        auto* h = history.getWritePointer (channel);
 
-                for (int i = 0; i < numSamples; ++i)
-                {
-                    wetData[i] = dryData[i] * (1.0f - mix) + wetData[i] * mix;
-                }
-            }
+        if (numSamples >= delay)
+        {
+            // [a b] -> [b a], then trade b (the newest `delay` samples) for the history
+            std::rotate (data, data + numSamples - delay, data + numSamples);
+            std::swap_ranges (data, data + delay, h);
+        }
+        else
+        {
+            // Output the oldest history samples, then queue the input behind the rest
+            std::swap_ranges (data, data + numSamples, h);
+            std::rotate (h, h + numSamples, h + delay);
         }
     }
 
 private:
-    //==========================================================================
-    // Tube waveshaping transfer function
-    //==========================================================================
-    static float tubeWaveshape (float x)
-    {
-        constexpr float bias = 0.15f;
-        const float saturated = std::tanh (x);
-        const float evenHarmonics = bias * (x * x) / (1.0f + std::abs (x));
-        return saturated + evenHarmonics;
-    }
+    juce::AudioBuffer<SampleType> history;
+    int delay = 0;
+};
+
+//==============================================================================
+// Transfer function implementation used by TubeSaturation's shaper stage.
+//   exact    — std::tanh per sample; the reference path
+//   rational — Pade tanh approximation, SIMD across samples,
+//              max error vs. exact below 1e-4 (about -80dB)
+//   table    — interpolated lookup table built in prepare(); see
+//              setLookupTableSize() / getLookupTableAccuracy()
+//   adaa1    — first-order antiderivative anti-aliasing (half a
+//              sample of group delay)
+//   adaa2    — second-order antiderivative anti-aliasing (one sample
+//              of delay, which is added to the reported latency at 1x)
+//==============================================================================
+enum class TubeShaperMode
+{
+    exact,
+    rational,
+    table,
+    adaa1,
+    adaa2
+};
+
+// Anti-aliasing filters for the oversampled shaper
+enum class TubeOversamplingFilter
+{
+    polyphaseIIR,
+    halfBandFIR
+};
+
+//==============================================================================
+// Tube-style saturation processor
+//
+// Emulates the asymmetric soft-clipping behavior of vacuum tubes.
+// Real tubes clip positive and negative halves differently, generating
+// even-order harmonics (2nd, 4th...) which sound "warm" and "musical."
+// The squared term in the transfer function creates this asymmetry.
+//
+// Templated on the sample type like the juce::dsp processors, so a host
+// running a 64-bit engine is processed in double throughout; the SIMD
+// paths then run at half the lane count.
+//==============================================================================
+template <typename SampleType>
+class TubeSaturation
+{
+public:
+    using ShaperMode = TubeShaperMode;
+    using OversamplingFilter = TubeOversamplingFilter;
+    using Table = WaveshaperTable<SampleType>;
+
+    TubeSaturation() = default;
+
+    // Oversampling factor is 2^order: 1x, 2x, 4x, 8x, 16x
+    static constexpr int maxOversamplingOrder = 4;
+
+    // The table spans the largest driven level we expect to see: full drive
+    // on a signal peaking at +6dBFS. Anything hotter is extrapolated.
+    static constexpr SampleType maxDriveDb = 40;
+    static constexpr SampleType tableHeadroom = 2;
+
+    void prepare (const juce::dsp::ProcessSpec& spec)
+    {
+        const juce::ScopedLock sl (oversamplerLock);
+
+        sampleRate = spec.sampleRate;
+        numChannels = static_cast<int> (spec.numChannels);
+        maximumBlockSize = static_cast<int> (spec.maximumBlockSize);
+
+        // Pre-gain (drive) and post-gain (output level), linear ramps over
+        // the block that carries each change
+        preGain.reset (sampleRate);
+        postGain.reset (sampleRate);
+        preGainRamp.resize (spec.maximumBlockSize);
+        postGainRamp.resize (spec.maximumBlockSize);
+
+        // Dry/wet mix, smoothed so blending in and out of 100% wet is click-free
+        mixSmoothed.reset (sampleRate);
+        mixRamp.resize (spec.maximumBlockSize);
+
+        // Tilt EQ for tone shaping
+        tiltEQ.prepare (sampleRate, numChannels, static_cast<int> (spec.maximumBlockSize));
+        tiltEQ.setKernels (*kernels);
+
+        // Transfer function table for ShaperMode::table, shared process-wide
+        shaperTable = shaperTableCache->get (lookupTableSize, [size = lookupTableSize]
+        {
+            const SampleType range = getLookupTableRange();
+            Table table;
+            table.initialise (tubeWaveshape, -range, range, size);
+            return table;
+        });
+
+        // Only the oversampler in use is built; any other arrives through
+        // buildRequestedOversampler() if it is ever selected. The delay
+        // lines are sized for the longest latency of them all.
+        for (size_t i = 0; i < oversamplers.size(); ++i)
+        {
+            readyOversamplers[i].store (nullptr, std::memory_order_relaxed);
+            oversamplers[i].reset();
+        }
+
+        const int requested = requestedOversampling.load (std::memory_order_relaxed);
+        oversamplingOrder = getRequestedOrder (requested);
+        oversamplingFilter = getRequestedFilter (requested);
+        currentOversampler = oversamplingOrder > 0 ? buildOversampler (oversamplingOrder, oversamplingFilter) : nullptr;
+
+        const int maxLatency = getMaxOversamplingLatency();
+
+        // Dry buffer for mix blending, delayed to match the oversampler
+        dryBuffer.setSize (numChannels,
+                           static_cast<int> (spec.maximumBlockSize));
+        dryDelay.prepare (numChannels, maxLatency + 1);
+        dryDelay.setDelay (getLatencySamples());
+
+        // Unprocessed channel (e.g. LFE), kept aligned with the rest
+        passthroughBuffer.setSize (1, static_cast<int> (spec.maximumBlockSize));
+        passthroughDelay.prepare (1, maxLatency + 1);
+        passthroughDelay.setDelay (getLatencySamples());
+
+        // Aligned per-channel scratch for the fused kernel's chunks
+        constexpr size_t alignment = juce::dsp::SIMDRegister<SampleType>::SIMDNumElements;
+        wetScratch.assign (static_cast<size_t> (numChannels * fusedChunkSize) + alignment, SampleType());
+        wetChannels.resize (static_cast<size_t> (numChannels));
+        for (int ch = 0; ch < numChannels; ++ch)
+            wetChannels[static_cast<size_t> (ch)] = juce::dsp::SIMDRegister<SampleType>::getNextSIMDAlignedPtr (wetScratch.data())
+                                                      + ch * fusedChunkSize;
+
+        // Antiderivative history per channel for the ADAA modes
+        adaaState.resize (static_cast<size_t> (numChannels));
+        resetAdaaState();
+
+        silentSamples = 0;
+        asleep = false;
+
+        mixState = getMixState();
+        selectKernel();
+    }
+
+    void reset()
+    {
+        preGain.setCurrentAndTargetValue (preGain.getTargetValue());
+        postGain.setCurrentAndTargetValue (postGain.getTargetValue());
+        mixSmoothed.setCurrentAndTargetValue (mixSmoothed.getTargetValue());
+        tiltEQ.reset();
+        dryDelay.reset();
+        passthroughDelay.reset();
+        resetAdaaState();
+        silentSamples = 0;
+        asleep = false;
+
+        const juce::ScopedLock sl (oversamplerLock);
+
+        for (auto& os : oversamplers)
+            if (os != nullptr)
+                os->reset();
+    }
+
+    // Set drive amount in dB (0 to 40)
+    void setDrive (SampleType driveDb)
+    {
+        preGain.setTargetValue (juce::Decibels::decibelsToGain (driveDb));
+    }
+
+    // Set output level in dB (-24 to +6)
+    void setOutput (SampleType outputDb)
+    {
+        postGain.setTargetValue (juce::Decibels::decibelsToGain (outputDb));
+    }
+
+    // Set dry/wet mix (0.0 to 1.0)
+    void setMix (SampleType newMix)
+    {
+        mixSmoothed.setTargetValue (newMix);
+    }
+
+    // Set tone tilt: -1.0 (dark) to +1.0 (bright), 0.0 = neutral
+    void setTone (SampleType toneValue)
+    {
+        tiltEQ.setTilt (toneValue);
+    }
+
+    // Leaves one channel unsaturated, e.g. the LFE of a surround bed; it is
+    // only delayed by the wet-path latency. -1 processes every channel.
+    // The delay line only runs while a channel passes through, so its
+    // history is cleared on every change rather than replayed stale (or
+    // from another channel) into the first block after it.
+    void setPassthroughChannel (int channel)
+    {
+        if (channel == passthroughChannel)
+            return;
+
+        passthroughChannel = channel;
+        passthroughDelay.reset();
+    }
+
+    void setShaperMode (ShaperMode newMode)
+    {
+        if (newMode == shaperMode)
+            return;
+
+        shaperMode = newMode;
+        resetAdaaState();
+        dryDelay.setDelay (getLatencySamples());
+        passthroughDelay.setDelay (getLatencySamples());
+        selectKernel();
+    }
+
+    ShaperMode getShaperMode() const { return shaperMode; }
+
+    // Number of table points; takes effect on the next prepare(). Memory is
+    // sizeof (SampleType) bytes per point (4 for float, 8 for double), once
+    // per process; accuracy improves with the square (linear) or cube
+    // (cubic) of the point density.
+    void setLookupTableSize (int numPoints)
+    {
+        lookupTableSize = juce::jmax (4, numPoints);
+    }
+
+    void setLookupTableInterpolation (typename Table::Interpolation newInterpolation)
+    {
+        tableInterpolation = newInterpolation;
+    }
+
+    // Instruction set for the float kernels (see SaturationKernels.h). The
+    // default, Tier::automatic, takes the widest one the CPU supports; a
+    // forced tier the CPU can't run falls back the same way. Safe to call
+    // from the audio thread. Double precision keeps its SIMDRegister code.
+    void setKernelTier (SaturationKernels::Tier newTier)
+    {
+        kernels = &SaturationKernels::getTable (newTier);
+        tiltEQ.setKernels (*kernels);
+    }
+
+    // The tier actually running, never Tier::automatic
+    SaturationKernels::Tier getKernelTier() const { return kernels->tier; }
+
+    // Per-stage cost of the last process() call, in
+    // juce::Time::getHighResolutionTicks() units. While enabled the clock is
+    // read at each stage boundary: four times per block in the staged chain,
+    // four times per 64-sample chunk (all channels together) in the fused
+    // one. A clock read costs about as much as the work in a short stage, so
+    // a timed block runs measurably slower; time a sample of blocks, not all
+    // of them. Disabled, each boundary is a well-predicted branch and the
+    // ticks stay at zero. Ramps, silence detection and passthrough are not
+    // attributed to any stage.
+    enum Stage
+    {
+        gainStage,
+        shaperStage,
+        tiltStage,
+        mixStage,
+        numStages
+    };
+
+    using StageTicks = std::array<juce::int64, numStages>;
+
+    void setStageTimingEnabled (bool shouldTime) { stageTiming = shouldTime; }
+    const StageTicks& getStageTicks() const { return stageTicks; }
+
+    // Safe to call from the audio thread. Each oversampler allocates stage
+    // buffers for every channel at its factor, so only the one in use is
+    // built by prepare(); selecting one that isn't built yet keeps the
+    // current setting running until buildRequestedOversampler() has made
+    // it, and process() switches on the next block. A switch resets the
+    // newly selected filters and moves the dry delay to the new latency.
+    void setOversampling (int newOrder, OversamplingFilter newFilter)
+    {
+        newOrder = juce::jlimit (0, maxOversamplingOrder, newOrder);
+        requestedOversampling.store (static_cast<int> (newFilter) * (maxOversamplingOrder + 1) + newOrder,
+                                     std::memory_order_relaxed);
+        applyRequestedOversampling();
+    }
+
+    // Off the audio thread (the processor calls it from a timer): builds
+    // the oversampler last passed to setOversampling() if it isn't built
+    // yet, and hands it to the audio thread. Built ones are kept until the
+    // next prepare(), so switching back to them is immediate.
+    void buildRequestedOversampler()
+    {
+        const juce::ScopedLock sl (oversamplerLock);
+
+        const int requested = requestedOversampling.load (std::memory_order_relaxed);
+        const int order = getRequestedOrder (requested);
+
+        if (maximumBlockSize > 0 && order > 0)
+            buildOversampler (order, getRequestedFilter (requested));
+    }
+
+    // True once the oversampling last asked for is the one running
+    bool isOversamplingApplied() const
+    {
+        const int requested = requestedOversampling.load (std::memory_order_relaxed);
+        return getRequestedOrder (requested) == oversamplingOrder && getRequestedFilter (requested) == oversamplingFilter;
+    }
+
+    int getOversamplingFactor() const { return 1 << oversamplingOrder; }
+
+    // Latency of the current oversampling setting, in host-rate samples.
+    // At 1x this includes the one-sample delay of second-order ADAA; when
+    // oversampled that delay is a fraction of a host sample and is ignored.
+    int getLatencySamples() const
+    {
+        if (auto* os = getCurrentOversampler())
+            return juce::roundToInt (os->getLatencyInSamples());
+
+        return shaperMode == ShaperMode::adaa2 ? 1 : 0;
+    }
+
+    static SampleType getLookupTableRange()
+    {
+        return juce::Decibels::decibelsToGain (maxDriveDb) * tableHeadroom;
+    }
+
+    // One sample of the memoryless curve the rational mode's block paths
+    // vectorise: the rational approximation, or its division-free series
+    // below quietThreshold. The block paths choose the series per block,
+    // not per sample, so they may differ from this by up to the series
+    // error (1.1e-6) as well as by rounding. Used by DSPBenchmark --verify.
+    static SampleType processShaperSample (SampleType x)
+    {
+        return std::abs (x) < quietThreshold ? tubeWaveshapeQuiet (x) : tubeWaveshapeRational (x);
+    }
+
+    // Accuracy of the prepared table against the analytic tubeWaveshape()
+    // over the inputs the current drive produces from a signal peaking at
+    // +6dBFS. The grid itself spans full drive whatever the setting, as the
+    // table is shared between instances. With cubic interpolation its error
+    // is about 3e-5 anywhere on it, below the rational shaper's 1e-4; linear
+    // needs about four times the points to match. Past the range the
+    // extrapolated line drifts from the curve by roughly 0.15 / (1 + |x|).
+    typename Table::Accuracy getLookupTableAccuracy() const
+    {
+        jassert (shaperTable != nullptr);  // prepare() first
+        const SampleType range = juce::jmin (getLookupTableRange(), preGain.getTargetValue() * tableHeadroom);
+        return shaperTable->measureAccuracy (tubeWaveshape, -range, range, tableInterpolation);
+    }
+
+    // How long the output keeps ringing after the input stops, in host-rate
+    // samples: the tilt filter's worst-case decay to the smallest normal
+    // float, plus the wet-path latency twice over as an estimate of the
+    // oversampling filters' ringing, plus a couple of samples of ADAA history.
+    int getTailSamples() const
+    {
+        return tiltEQ.getDecaySamples() + 2 * getLatencySamples() + 2;
+    }
+
+    double getTailLengthSeconds() const
+    {
+        return static_cast<double> (getTailSamples()) / sampleRate;
+    }
+
+    // Blocks larger than the prepared size (some hosts do this when bouncing
+    // or freezing) are processed in prepared-size chunks. The chunks refer
+    // to the host's memory; AudioBuffer keeps the channel pointers of up to
+    // 32 channels inline, so nothing is allocated. Filter and smoother state
+    // simply carries over from one chunk to the next.
+    void process (juce::AudioBuffer<SampleType>& buffer)
+    {
+        const int numSamples = buffer.getNumSamples();
+        jassert (maximumBlockSize > 0);  // prepare() first
+
+        // An oversampler built since the last block takes over here
+        applyRequestedOversampling();
+
+        // Parameter changes ramp across the whole host block, even when it
+        // is processed in several chunks below
+        preGain.applyPendingTarget (numSamples);
+        postGain.applyPendingTarget (numSamples);
+        mixSmoothed.applyPendingTarget (numSamples);
+        tiltEQ.applyPendingTarget (numSamples);
+        stageTicks.fill (0);
+
+        if (numSamples <= maximumBlockSize)
+        {
+            processChunk (buffer);
+            return;
+        }
+
+        oversizedBlocks.fetch_add (1, std::memory_order_relaxed);
+
+        for (int start = 0; start < numSamples; start += maximumBlockSize)
+        {
+            juce::AudioBuffer<SampleType> chunk (buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                                 start, juce::jmin (maximumBlockSize, numSamples - start));
+            processChunk (chunk);
+        }
+    }
+
+    // Number of blocks that arrived larger than the size given to prepare()
+    juce::uint32 getOversizedBlockCount() const noexcept
+    {
+        return oversizedBlocks.load (std::memory_order_relaxed);
+    }
+
+private:
+    void processChunk (juce::AudioBuffer<SampleType>& buffer)
+    {
+        const int numSamples = buffer.getNumSamples();
+        jassert (numSamples <= static_cast<int> (preGainRamp.size()));
+        jassert (buffer.getNumChannels() == numChannels);
+
+        if (skipSilence (buffer))
+            return;
+
+        const auto state = getMixState();
+        if (state != mixState)
+        {
+            // Leaving bypass: the wet path was idle, start it from silence
+            // while the mix ramps in from zero
+            if (mixState == MixState::bypass)
+                resetWetPath();
+
+            mixState = state;
+            selectKernel();
+        }
+
+        if (mixState == MixState::bypass)
+        {
+            preGain.skip (numSamples);
+            postGain.skip (numSamples);
+            tiltEQ.beginBlock (numSamples);
+        }
+        else
+        {
+            // Per-sample gains for this block, shared by every channel
+            fillRamp (preGain, preGainRamp.data(), numSamples);
+            fillRamp (postGain, postGainRamp.data(), numSamples);
+            tiltEQ.beginBlock (numSamples);
+
+            if (mixState == MixState::blend)
+                fillRamp (mixSmoothed, mixRamp.data(), numSamples);
+        }
+
+        const bool passthrough = juce::isPositiveAndBelow (passthroughChannel, buffer.getNumChannels());
+
+        if (passthrough)
+        {
+            passthroughBuffer.copyFrom (0, 0, buffer, passthroughChannel, 0, numSamples);
+            passthroughDelay.process (0, passthroughBuffer.getWritePointer (0), numSamples);
+        }
+
+        (this->*kernel) (buffer);
+
+        if (passthrough)
+            buffer.copyFrom (passthroughChannel, 0, passthroughBuffer, 0, 0, numSamples);
+    }
+
+    //==========================================================================
+    // Silence skip
+    //
+    // The transfer function maps 0 to 0, so once the input has been digital
+    // silence for longer than the tail, every filter and delay holds nothing
+    // but (sub)denormal residue and the output is silence too. From then on
+    // the zero input is left as it is; the ramps still advance so parameter
+    // moves made during silence are in place when the signal returns. The
+    // state is cleared once on the way in so it resumes from exact zeros.
+    //==========================================================================
+    bool skipSilence (juce::AudioBuffer<SampleType>& buffer)
+    {
+        const int numSamples = buffer.getNumSamples();
+
+        if (! juce::exactlyEqual (buffer.getMagnitude (0, numSamples), SampleType (0)))
+        {
+            silentSamples = 0;
+            asleep = false;
+            return false;
+        }
+
+        if (silentSamples < getTailSamples())
+        {
+            silentSamples += numSamples;
+            return false;
+        }
+
+        if (! asleep)
+        {
+            resetWetPath();
+            dryDelay.reset();
+            passthroughDelay.reset();
+            asleep = true;
+        }
+
+        preGain.skip (numSamples);
+        postGain.skip (numSamples);
+        mixSmoothed.skip (numSamples);
+        tiltEQ.beginBlock (numSamples);
+        return true;
+    }
+
+    //==========================================================================
+    // Kernel selection
+    //
+    // The per-block work is specialised at compile time on the channel count
+    // (mono, stereo, or any count) and on the mix state, so the stereo loops
+    // unroll and the dry path disappears entirely when fully wet. The
+    // matching kernel is picked in prepare() and whenever the mix state or
+    // the wet-path latency changes; process() just calls through it.
+    //
+    // Without wet-path latency everything runs in a single fused pass;
+    // oversampling (and ADAA2's one-sample delay) needs the staged chain.
+    //==========================================================================
+    enum class MixState
+    {
+        wet,     // mix at 1: no dry signal in the output
+        blend,   // mix between 0 and 1, or moving
+        bypass   // mix at 0: dry only, the wet path is skipped
+    };
+
+    using Kernel = void (TubeSaturation::*) (juce::AudioBuffer<SampleType>&);
+
+    MixState getMixState() const
+    {
+        if (mixSmoothed.isSmoothing())
+            return MixState::blend;
+
+        const auto target = mixSmoothed.getTargetValue();
+        return target >= 1 ? MixState::wet : (target <= 0 ? MixState::bypass : MixState::blend);
+    }
+
+    void selectKernel()
+    {
+        switch (mixState)
+        {
+            case MixState::wet:    kernel = chooseKernel<MixState::wet>();    break;
+            case MixState::bypass: kernel = chooseKernel<MixState::bypass>(); break;
+            case MixState::blend:
+            default:               kernel = chooseKernel<MixState::blend>();  break;
+        }
+    }
+
+    template <MixState state>
+    Kernel chooseKernel() const
+    {
+        const bool staged = dryDelay.getDelay() != 0;
+
+        switch (numChannels)
+        {
+            case 1:  return staged ? &TubeSaturation::processStaged<1, state> : &TubeSaturation::processFused<1, state>;
+            case 2:  return staged ? &TubeSaturation::processStaged<2, state> : &TubeSaturation::processFused<2, state>;
+            default: return staged ? &TubeSaturation::processStaged<0, state> : &TubeSaturation::processFused<0, state>;
+        }
+    }
+
+    void startStageClock()
+    {
+        if (stageTiming)
+            stageClock = juce::Time::getHighResolutionTicks();
+    }
+
+    // Charges the time since the previous boundary to `stage`
+    void endStage (Stage stage)
+    {
+        if (stageTiming)
+        {
+            const auto now = juce::Time::getHighResolutionTicks();
+            stageTicks[stage] += now - stageClock;
+            stageClock = now;
+        }
+    }
+
+    // Clears everything that carries wet-path history
+    void resetWetPath()
+    {
+        tiltEQ.reset();
+        resetAdaaState();
+
+        if (auto* os = getCurrentOversampler())
+            os->reset();
+    }
+
+    //==========================================================================
+    // Fused kernel: pre-gain, shaper, tilt, post-gain and mix in one pass.
+    // The block is walked in small chunks; each chunk is driven and shaped
+    // per channel into an aligned scratch that stays in L1, filtered with
+    // all channels packed side by side, then blended back with the dry
+    // sample read straight from the input just before it is overwritten.
+    //
+    // `fixedChannels` is the channel count, or 0 to take it from the buffer.
+    //==========================================================================
+    static constexpr int fusedChunkSize = 64;
+
+    template <int fixedChannels, MixState state>
+    void processFused (juce::AudioBuffer<SampleType>& buffer)
+    {
+        // Without latency a bypassed block is already the dry signal
+        if constexpr (state == MixState::bypass)
+            return;
+
+        const int channels   = fixedChannels > 0 ? fixedChannels : buffer.getNumChannels();
+        const int numSamples = buffer.getNumSamples();
+        const SampleType* pre  = preGainRamp.data();
+        const SampleType* post = postGainRamp.data();
+        const SampleType* mix  = mixRamp.data();
+
+        startStageClock();
+
+        for (int start = 0; start < numSamples; start += fusedChunkSize)
+        {
+            const int length = juce::jmin (fusedChunkSize, numSamples - start);
+
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                const SampleType* x = buffer.getReadPointer (ch, start);
+                SampleType* wet = wetChannels[static_cast<size_t> (ch)];
+
+                for (int i = 0; i < length; ++i)
+                    wet[i] = x[i] * pre[start + i];
+            }
+
+            endStage (gainStage);
+
+            for (int ch = 0; ch < channels; ++ch)
+                shapeBlock (ch, wetChannels[static_cast<size_t> (ch)], length);
+
+            endStage (shaperStage);
+
+            tiltEQ.processBlock (wetChannels.data(), channels, start, length);
+            endStage (tiltStage);
+
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                SampleType* x = buffer.getWritePointer (ch, start);
+                const SampleType* wet = wetChannels[static_cast<size_t> (ch)];
+
+                if constexpr (std::is_same_v<SampleType, float>)
+                {
+                    if constexpr (state == MixState::wet)
+                        kernels->applyGain (x, wet, post + start, length);
+                    else
+                        kernels->applyGainAndMix (x, wet, post + start, mix + start, length);
+
+                    continue;
+                }
+
+                for (int i = 0; i < length; ++i)
+                {
+                    const SampleType y = wet[i] * post[start + i];
+
+                    if constexpr (state == MixState::wet)
+                        x[i] = y;
+                    else
+                        x[i] = x[i] * (1 - mix[start + i]) + y * mix[start + i];
+                }
+            }
+
+            endStage (mixStage);
+        }
+    }
+
+    //==========================================================================
+    // Staged chain, used when the wet path has latency: the dry copy is
+    // delayed to match, and the shaper may run at the oversampled rate.
+    //==========================================================================
+    template <int fixedChannels, MixState state>
+    void processStaged (juce::AudioBuffer<SampleType>& buffer)
+    {
+        const int channels   = fixedChannels > 0 ? fixedChannels : buffer.getNumChannels();
+        const int numSamples = buffer.getNumSamples();
+        startStageClock();
+
+        // Bypassed, the output is just the dry signal at the wet latency
+        if constexpr (state == MixState::bypass)
+        {
+            for (int ch = 0; ch < channels; ++ch)
+                dryDelay.process (ch, buffer.getWritePointer (ch), numSamples);
+
+            endStage (mixStage);
+            return;
+        }
+
+        // Save dry signal for mix blending, aligned with the wet latency.
+        // Fully wet, only the delay history is kept up to date so a later
+        // move of the mix control starts from the right dry samples.
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            if constexpr (state == MixState::blend)
+            {
+                dryBuffer.copyFrom (ch, 0, buffer, ch, 0, numSamples);
+                dryDelay.process (ch, dryBuffer.getWritePointer (ch), numSamples);
+            }
+            else
+            {
+                dryDelay.advance (ch, buffer.getReadPointer (ch), numSamples);
+            }
+        }
+
+        endStage (mixStage);
+
+        // Apply drive (pre-gain)
+        for (int ch = 0; ch < channels; ++ch)
+            juce::FloatVectorOperations::multiply (buffer.getWritePointer (ch), preGainRamp.data(), numSamples);
+
+        endStage (gainStage);
+
+        // Apply tube-style waveshaping, at the oversampled rate if enabled
+        juce::dsp::AudioBlock<SampleType> block (buffer);
+
+        if (auto* os = getCurrentOversampler())
+        {
+            auto upBlock = os->processSamplesUp (block);
+
+            for (int ch = 0; ch < channels; ++ch)
+                shapeBlock (ch, upBlock.getChannelPointer (static_cast<size_t> (ch)),
+                            static_cast<int> (upBlock.getNumSamples()));
+
+            os->processSamplesDown (block);
+        }
+        else
+        {
+            for (int ch = 0; ch < channels; ++ch)
+                shapeBlock (ch, buffer.getWritePointer (ch), numSamples);
+        }
+
+        endStage (shaperStage);
+
+        // Tilt EQ, all channels together
+        tiltEQ.processBlock (buffer.getArrayOfWritePointers(), channels, 0, numSamples);
+        endStage (tiltStage);
+
+        // Apply output gain
+        for (int ch = 0; ch < channels; ++ch)
+            juce::FloatVectorOperations::multiply (buffer.getWritePointer (ch), postGainRamp.data(), numSamples);
+
+        // Dry/wet mix blending
+        if constexpr (state == MixState::blend)
+        {
+            const SampleType* mix = mixRamp.data();
+
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                auto* wetData = buffer.getWritePointer (ch);
+                const auto* dryData = dryBuffer.getReadPointer (ch);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    wetData[i] = dryData[i] * (1 - mix[i]) + wetData[i] * mix[i];
+                }
+            }
+        }
+
+        endStage (mixStage);
+    }
+
+    static void fillRamp (ParameterRamp<SampleType>& value, SampleType* ramp, int numSamples)
+    {
+        if (value.isSmoothing())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                ramp[i] = value.getNextValue();
+        }
+        else
+        {
+            juce::FloatVectorOperations::fill (ramp, value.getTargetValue(), numSamples);
+        }
+    }
+
+    void shapeBlock (int channel, SampleType* data, int numSamples)
+    {
+        switch (shaperMode)
+        {
+            case ShaperMode::exact:
+                for (int i = 0; i < numSamples; ++i)
+                    data[i] = tubeWaveshape (data[i]);
+                break;
+
+            case ShaperMode::table:
+                if (isQuiet (data, numSamples))
+                    shapeQuietBlock (data, numSamples);
+                else
+                    shaperTable->processBlock (data, numSamples, tableInterpolation);
+                break;
+
+            case ShaperMode::adaa1:
+                processAdaa1 (adaaState[static_cast<size_t> (channel)], data, numSamples);
+                break;
+
+            case ShaperMode::adaa2:
+                processAdaa2 (adaaState[static_cast<size_t> (channel)], data, numSamples);
+                break;
+
+            case ShaperMode::rational:
+            default:
+                if (isQuiet (data, numSamples))
+                    shapeQuietBlock (data, numSamples);
+                else if constexpr (std::is_same_v<SampleType, float>)
+                    kernels->shapeRational (data, numSamples);
+                else
+                    tubeWaveshapeRationalBlock (data, numSamples);
+                break;
+        }
+    }
+
+    void shapeQuietBlock (SampleType* data, int numSamples) const
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+            kernels->shapeQuiet (data, numSamples);
+        else
+            tubeWaveshapeQuietBlock (data, numSamples);
+    }
+
+    static bool isQuiet (const SampleType* data, int numSamples)
+    {
+        const auto range = juce::FloatVectorOperations::findMinAndMax (data, numSamples);
+        return range.getStart() > -quietThreshold && range.getEnd() < quietThreshold;
+    }
+
+    static size_t getOversamplerIndex (int order, OversamplingFilter filter)
+    {
+        return static_cast<size_t> (filter) * maxOversamplingOrder + static_cast<size_t> (order - 1);
+    }
+
+    juce::dsp::Oversampling<SampleType>* getCurrentOversampler() const
+    {
+        return currentOversampler;
+    }
+
+    static int getRequestedOrder (int requested)
+    {
+        return requested % (maxOversamplingOrder + 1);
+    }
+
+    static OversamplingFilter getRequestedFilter (int requested)
+    {
+        return static_cast<OversamplingFilter> (requested / (maxOversamplingOrder + 1));
+    }
+
+    static std::unique_ptr<juce::dsp::Oversampling<SampleType>> makeOversampler (int channels, int order,
+                                                                                 OversamplingFilter filter, int maxBlock)
+    {
+        auto os = std::make_unique<juce::dsp::Oversampling<SampleType>> (
+            static_cast<size_t> (channels), static_cast<size_t> (order),
+            filter == OversamplingFilter::polyphaseIIR ? juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR
+                                                       : juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple,
+            true, true);
+        os->initProcessing (static_cast<size_t> (maxBlock));
+        return os;
+    }
+
+    // Called with oversamplerLock held, never on the audio thread
+    juce::dsp::Oversampling<SampleType>* buildOversampler (int order, OversamplingFilter filter)
+    {
+        const auto index = getOversamplerIndex (order, filter);
+        auto& os = oversamplers[index];
+
+        if (os == nullptr)
+        {
+            os = makeOversampler (numChannels, order, filter, maximumBlockSize);
+            readyOversamplers[index].store (os.get(), std::memory_order_release);
+        }
+
+        return os.get();
+    }
+
+    // The longest latency of any factor and filter, which sizes the delay
+    // lines. It depends on neither the channel count nor the block size,
+    // so it is found once per process, on one-channel oversamplers.
+    static int getMaxOversamplingLatency()
+    {
+        static const int maxLatency = []
+        {
+            int latency = 0;
+
+            for (auto filter : { OversamplingFilter::polyphaseIIR, OversamplingFilter::halfBandFIR })
+                for (int order = 1; order <= maxOversamplingOrder; ++order)
+                    latency = juce::jmax (latency, juce::roundToInt (makeOversampler (1, order, filter, 1)->getLatencyInSamples()));
+
+            return latency;
+        }();
+
+        return maxLatency;
+    }
+
+    // Audio thread: switches to the requested oversampling once its
+    // oversampler has been handed over
+    void applyRequestedOversampling()
+    {
+        if (isOversamplingApplied())
+            return;
+
+        const int requested = requestedOversampling.load (std::memory_order_relaxed);
+        const int order = getRequestedOrder (requested);
+        const auto filter = getRequestedFilter (requested);
+        juce::dsp::Oversampling<SampleType>* os = nullptr;
+
+        if (order > 0)
+        {
+            os = readyOversamplers[getOversamplerIndex (order, filter)].load (std::memory_order_acquire);
+
+            if (os == nullptr)
+                return;
+
+            os->reset();
+        }
+
+        oversamplingOrder = order;
+        oversamplingFilter = filter;
+        currentOversampler = os;
+
+        dryDelay.setDelay (getLatencySamples());
+        passthroughDelay.setDelay (getLatencySamples());
+        selectKernel();
+    }
+
+    //==========================================================================
+    // Tube waveshaping transfer function
+    //==========================================================================
+    static SampleType tubeWaveshape (SampleType x)
+    {
+        constexpr SampleType bias = static_cast<SampleType> (0.15);
+        const SampleType saturated = std::tanh (x);
+        const SampleType evenHarmonics = bias * (x * x) / (1 + std::abs (x));
+        return saturated + evenHarmonics;
+    }
+
+    //==========================================================================
+    // Rational approximation of the same transfer function
+    //
+    // tanh is replaced by the [7/6] Pade approximant with the input clamped to
+    // +/-4.97, where the approximant meets 1.0 without overshooting. Over the
+    // whole real line the error is below 1e-4. Both fractions are put over a
+    // common denominator so each sample costs a single division.
+    //==========================================================================
+    static constexpr SampleType rationalClamp = static_cast<SampleType> (4.97);
+
+    template <typename T>
+    static T tubeWaveshapeRational (T x)
+    {
+        constexpr T bias = static_cast<T> (0.15);
+        const T xc = juce::jlimit (static_cast<T> (-rationalClamp), static_cast<T> (rationalClamp), x);
+        const T xc2 = xc * xc;
+        const T num = xc * (static_cast<T> (135135) + xc2 * (static_cast<T> (17325) + xc2 * (static_cast<T> (378) + xc2)));
+        const T den = static_cast<T> (135135) + xc2 * (static_cast<T> (62370) + xc2 * (static_cast<T> (3150) + xc2 * static_cast<T> (28)));
+        const T absPlusOne = static_cast<T> (1) + std::abs (x);
+        return (num * absPlusOne + bias * (x * x) * den) / (den * absPlusOne);
+    }
+
+    template <typename T>
+    static juce::dsp::SIMDRegister<T> tubeWaveshapeRational (juce::dsp::SIMDRegister<T> x)
+    {
+        using Vec = juce::dsp::SIMDRegister<T>;
+        const Vec xc = Vec::min (Vec::expand (static_cast<T> (rationalClamp)),
+                                 Vec::max (Vec::expand (static_cast<T> (-rationalClamp)), x));
+        const Vec xc2 = xc * xc;
+        const Vec num = xc * (xc2 * (xc2 * (xc2 + static_cast<T> (378)) + static_cast<T> (17325)) + static_cast<T> (135135));
+        const Vec den = xc2 * (xc2 * (xc2 * static_cast<T> (28) + static_cast<T> (3150)) + static_cast<T> (62370)) + static_cast<T> (135135);
+        const Vec absPlusOne = Vec::abs (x) + static_cast<T> (1);
+        return SIMDHelpers::divide (num * absPlusOne + x * x * den * static_cast<T> (0.15),
+                                    den * absPlusOne);
+    }
+
+    template <typename T>
+    static void tubeWaveshapeRationalBlock (T* data, int numSamples)
+    {
+        processAligned (data, numSamples, [] (auto x) { return tubeWaveshapeRational (x); });
+    }
+
+    //==========================================================================
+    // Low-level fast path
+    //
+    // Below |x| = 0.094 the transfer function is replaced by its power
+    // series, with no division:
+    //
+    //   tanh(x)              ~ x - x^3/3                 error <= 2|x|^5/15
+    //   0.15 x^2 / (1 + |x|) ~ 0.15 x^2 (1 - |x| + x^2 - |x|^3)
+    //                                                    error <= 0.15 x^6
+    //
+    // so the total error is at most 1.1e-6 (about -120dB), well inside the
+    // error of the rational and table shapers it stands in for. Since both
+    // paths agree that closely at the threshold and neither has memory,
+    // switching between them block by block is inaudible. The reference
+    // (exact) shaper and the stateful ADAA shapers never take it.
+    //==========================================================================
+    static constexpr SampleType quietThreshold = static_cast<SampleType> (0.094);
+
+    template <typename T>
+    static T tubeWaveshapeQuiet (T x)
+    {
+        const T ax = std::abs (x);
+        const T x2 = x * x;
+        const T bias = static_cast<T> (0.15) * x2 * (static_cast<T> (1) - ax + x2 * (static_cast<T> (1) - ax));
+        return x - x * x2 * static_cast<T> (1.0 / 3.0) + bias;
+    }
+
+    template <typename T>
+    static juce::dsp::SIMDRegister<T> tubeWaveshapeQuiet (juce::dsp::SIMDRegister<T> x)
+    {
+        using Vec = juce::dsp::SIMDRegister<T>;
+        const Vec ax = Vec::abs (x);
+        const Vec x2 = x * x;
+        const Vec one = Vec::expand (static_cast<T> (1));
+        const Vec bias = x2 * (one - ax + x2 * (one - ax)) * static_cast<T> (0.15);
+        return x - x * x2 * static_cast<T> (1.0 / 3.0) + bias;
+    }
+
+    template <typename T>
+    static void tubeWaveshapeQuietBlock (T* data, int numSamples)
+    {
+        processAligned (data, numSamples, [] (auto x) { return tubeWaveshapeQuiet (x); });
+    }
+
+    // Scalar head/tail around an aligned SIMD body; `shaper` takes either
+    // a sample or a SIMDRegister of samples
+    template <typename T, typename Shaper>
+    static void processAligned (T* data, int numSamples, Shaper&& shaper)
+    {
+        using Vec = juce::dsp::SIMDRegister<T>;
+        constexpr int width = static_cast<int> (Vec::size());
+
+        auto* aligned = Vec::getNextSIMDAlignedPtr (data);
+        const int head = juce::jmin (numSamples, static_cast<int> (aligned - data));
+        const int body = ((numSamples - head) / width) * width;
+
+        for (int i = 0; i < head; ++i)
+            data[i] = shaper (data[i]);
+
+        for (int i = head; i < head + body; i += width)
+            shaper (Vec::fromRawArray (data + i)).copyToRawArray (data + i);
+
+        for (int i = head + body; i < numSamples; ++i)
+            data[i] = shaper (data[i]);
+    }
+
+    //==========================================================================
+    // Antiderivative anti-aliasing
+    //
+    // With f(x) = tanh(x) + b * x^2 / (1 + |x|):
+    //
+    //   F1(x) = log cosh(x) + b * sgn(x) * (x^2/2 - |x| + ln(1 + |x|))
+    //   F2(x) = sgn(x) * (x^2/2 - |x| ln2 + Li2(-e^(-2|x|))/2 + pi^2/24)
+    //         + b * (|x|^3/6 - x^2/2 + (1 + |x|) ln(1 + |x|) - |x|)
+    //
+    // log cosh and Li2 share u = e^(-2|x|) and w = ln(1 + u), since
+    // log cosh(x) = |x| + w - ln2 and Li2(-u) is a short Bernoulli series in w.
+    //
+    // The divided differences cancel badly, so all of this runs in double.
+    // Ill-conditioned differences are resolved with selects rather than
+    // branches: both candidates are computed and the safe one is kept.
+    //==========================================================================
+    struct AdaaState
+    {
+        double x1 = 0.0, x2 = 0.0;   // x[n-1], x[n-2]
+        double f1 = 0.0;             // F1 (x[n-1])
+        double f2 = 0.0;             // F2 (x[n-1])
+        double d1 = 0.0;             // (F2 (x[n-1]) - F2 (x[n-2])) / (x[n-1] - x[n-2])
+    };
+
+    struct Antiderivatives
+    {
+        double first, second;
+    };
+
+    static Antiderivatives tubeAntiderivatives (double x)
+    {
+        constexpr double bias = 0.15;
+        constexpr double ln2 = 0.69314718055994530942;
+        constexpr double piSquaredOver24 = 0.41123351671205660911;
+
+        const double ax = std::abs (x);
+        const double sign = x < 0.0 ? -1.0 : 1.0;
+        const double w = std::log1p (std::exp (-2.0 * ax));
+        const double w2 = w * w;
+
+        // Li2(-e^(-2|x|)), via Li2(z) = -Li2(z / (z - 1)) - ln^2(1 - z) / 2
+        const double dilog = -w - w2 * (0.25 + w * (1.0 / 36.0 - w2 * (1.0 / 3600.0
+                                 - w2 * (1.0 / 211680.0 - w2 * (1.0 / 10886400.0
+                                 - w2 * (1.0 / 526901760.0))))));
+
+        const double lnOnePlusAx = std::log1p (ax);
+        const double x2 = x * x;
+
+        return { ax + w - ln2 + bias * sign * (0.5 * x2 - ax + lnOnePlusAx),
+                 sign * (0.5 * x2 - ax * ln2 + 0.5 * dilog + piSquaredOver24)
+                   + bias * (x2 * ax / 6.0 - 0.5 * x2 + (1.0 + ax) * lnOnePlusAx - ax) };
+    }
+
+    void resetAdaaState()
+    {
+        std::fill (adaaState.begin(), adaaState.end(), AdaaState {});
+    }
+
+    // y[n] = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1]), or f at the midpoint
+    static void processAdaa1 (AdaaState& state, SampleType* data, int numSamples)
+    {
+        constexpr double tolerance = 1.0e-5;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double x = static_cast<double> (data[i]);
+            const double f1 = tubeAntiderivatives (x).first;
+            const double dx = x - state.x1;
+
+            const bool illConditioned = std::abs (dx) < tolerance;
+            const double divided = (f1 - state.f1) / (illConditioned ? 1.0 : dx);
+            const double midpoint = static_cast<double> (tubeWaveshapeRational (static_cast<SampleType> (0.5 * (x + state.x1))));
+
+            data[i] = static_cast<SampleType> (illConditioned ? midpoint : divided);
+            state.x1 = x;
+            state.f1 = f1;
+        }
+    }
+
+    // y[n] = 2 / (x[n] - x[n-2]) * (D(x[n], x[n-1]) - D(x[n-1], x[n-2])),
+    // with D(a, b) = (F2(a) - F2(b)) / (a - b).
+    //
+    // As x[n] -> x[n-2] the limit is 2 * (F1(x[n]) - D(x[n], x[n-1])) / (x[n] - x[n-1]),
+    // which only needs values already computed; when all three inputs
+    // coincide the output is simply f(x[n-1]).
+    static void processAdaa2 (AdaaState& state, SampleType* data, int numSamples)
+    {
+        constexpr double tolerance = 1.0e-3;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double x = static_cast<double> (data[i]);
+            const auto antiderivatives = tubeAntiderivatives (x);
+
+            const double dx1 = x - state.x1;
+            const bool ill1 = std::abs (dx1) < tolerance;
+            const double d = ill1 ? 0.5 * (antiderivatives.first + state.f1)
+                                  : (antiderivatives.second - state.f2) / (ill1 ? 1.0 : dx1);
+
+            const double dx2 = x - state.x2;
+            const bool ill2 = std::abs (dx2) < tolerance;
+            const double curvature = 2.0 * (d - state.d1) / (ill2 ? 1.0 : dx2);
+            const double limit = 2.0 * (antiderivatives.first - d) / (ill1 ? 1.0 : dx1);
+            const double centre = static_cast<double> (tubeWaveshapeRational (static_cast<SampleType> (state.x1)));
+
+            data[i] = static_cast<SampleType> (ill2 ? (ill1 ? centre : limit) : curvature);
+
+            state.x2 = state.x1;
+            state.x1 = x;
+            state.f1 = antiderivatives.first;
+            state.f2 = antiderivatives.second;
+            state.d1 = d;
+        }
+    }
 
     double sampleRate = 44100.0;
     int numChannels = 2;
-    float mix = 1.0f;
+    int maximumBlockSize = 0;
+    std::atomic<juce::uint32> oversizedBlocks { 0 };
+    ShaperMode shaperMode = ShaperMode::rational;
+    std::vector<AdaaState> adaaState;
+
+    // Keyed by point count; the range is fixed, so that is the whole key
+    juce::SharedResourcePointer<SharedTableCache<int, Table>> shaperTableCache;
+    std::shared_ptr<const Table> shaperTable;
+    int lookupTableSize = 8192;
+    typename Table::Interpolation tableInterpolation = Table::Interpolation::cubic;
+
+    ParameterRamp<SampleType> preGain { 1 };
+    ParameterRamp<SampleType> postGain { 1 };
+    std::vector<SampleType> preGainRamp, postGainRamp;
+
+    ParameterRamp<SampleType> mixSmoothed { 1 };
+    std::vector<SampleType> mixRamp;
+    MixState mixState = MixState::wet;
+    Kernel kernel = &TubeSaturation::processFused<0, MixState::wet>;
+    TiltEQ<SampleType> tiltEQ;
+    const SaturationKernels::Table* kernels = &SaturationKernels::getTable (SaturationKernels::Tier::automatic);
+
+    juce::AudioBuffer<SampleType> dryBuffer;
+    DryDelay<SampleType> dryDelay;
+
+    int passthroughChannel = -1;
+
+    int silentSamples = 0;
+    bool asleep = false;
+    juce::AudioBuffer<SampleType> passthroughBuffer;
+    DryDelay<SampleType> passthroughDelay;
+
+    std::vector<SampleType> wetScratch;
+    std::vector<SampleType*> wetChannels;
+
+    bool stageTiming = false;
+    juce::int64 stageClock = 0;
+    StageTicks stageTicks {};
 
-    juce::dsp::Gain<float> preGain;
-    juce::dsp::Gain<float> postGain;
-    TiltEQ tiltEQ;
+    int oversamplingOrder = 0;
+    OversamplingFilter oversamplingFilter = OversamplingFilter::polyphaseIIR;
+    juce::dsp::Oversampling<SampleType>* currentOversampler = nullptr;
 
-    juce::AudioBuffer<float> dryBuffer;
+    // Owned here and touched only off the audio thread, under the lock;
+    // the audio thread picks a built one up from readyOversamplers.
+    // requestedOversampling packs the order and filter into one value.
+    std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, 2 * maxOversamplingOrder> oversamplers;
+    std::array<std::atomic<juce::dsp::Oversampling<SampleType>*>, 2 * maxOversamplingOrder> readyOversamplers {};
+    std::atomic<int> requestedOversampling { 0 };
+    juce::CriticalSection oversamplerLock;
 };
@@ -0,0 +1,129 @@
+#include <JuceHeader.h>
+#include "SaturationKernels.h"
+
+#include <cstring>
+
+#if defined (__i386__) || defined (__amd64__) || defined (_M_X64) || defined (_X86_) || defined (_M_IX86)
+ #define WARMSAT_X86 1
+ #if defined (_MSC_VER)
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#else
+ #define WARMSAT_X86 0
+#endif
+
+namespace SaturationKernels
+{
+    static const Table* getCompiledTable (Tier tier)
+    {
+        switch (tier)
+        {
+            case Tier::scalar: return getScalarTable();
+            case Tier::sse2:   return getSSE2Table();
+            case Tier::avx2:   return getAVX2Table();
+            case Tier::avx512: return getAVX512Table();
+            case Tier::neon:   return getNEONTable();
+            case Tier::automatic:
+            default:           return nullptr;
+        }
+    }
+
+   #if WARMSAT_X86
+    // The CPU flags alone don't say whether the OS saves the wider registers
+    // on a context switch; without that, AVX code faults or gets its upper
+    // lanes clobbered. XCR0 (read with xgetbv, valid only if OSXSAVE is set)
+    // lists the register state the OS has enabled.
+    static juce::uint64 getEnabledRegisterState()
+    {
+       #if defined (_MSC_VER)
+        int info[4] = {};
+        __cpuid (info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+       #else
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        const bool osxsave = __get_cpuid (1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 27)) != 0;
+       #endif
+
+        if (! osxsave)
+            return 0;
+
+       #if defined (_MSC_VER)
+        return static_cast<juce::uint64> (_xgetbv (0));
+       #else
+        // Spelled out rather than _xgetbv(), which needs -mxsave on GCC
+        unsigned int lo = 0, hi = 0;
+        __asm__ __volatile__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+        return (static_cast<juce::uint64> (hi) << 32) | lo;
+       #endif
+    }
+
+    static bool osSavesRegisters (juce::uint64 mask)
+    {
+        static const juce::uint64 enabled = getEnabledRegisterState();
+        return (enabled & mask) == mask;
+    }
+
+    static constexpr juce::uint64 xmmYmmState = 0x06;  // XCR0 bits 1-2: SSE and AVX
+    static constexpr juce::uint64 avx512State = 0xe0;  // XCR0 bits 5-7: opmask, ZMM0-15 upper halves, ZMM16-31
+   #endif
+
+    static bool cpuHas (Tier tier)
+    {
+        switch (tier)
+        {
+            case Tier::scalar: return true;
+            case Tier::sse2:   return juce::SystemStats::hasSSE2();
+           #if WARMSAT_X86
+            case Tier::avx2:   return juce::SystemStats::hasAVX2() && osSavesRegisters (xmmYmmState);
+            case Tier::avx512: return juce::SystemStats::hasAVX512F() && osSavesRegisters (xmmYmmState | avx512State);
+           #else
+            case Tier::avx2:   return juce::SystemStats::hasAVX2();
+            case Tier::avx512: return juce::SystemStats::hasAVX512F();
+           #endif
+            case Tier::neon:   return juce::SystemStats::hasNeon();
+            case Tier::automatic:
+            default:           return false;
+        }
+    }
+
+    bool isSupported (Tier tier)
+    {
+        return getCompiledTable (tier) != nullptr && cpuHas (tier);
+    }
+
+    Tier getWidestSupportedTier()
+    {
+        for (auto tier : { Tier::avx512, Tier::avx2, Tier::neon, Tier::sse2 })
+            if (isSupported (tier))
+                return tier;
+
+        return Tier::scalar;
+    }
+
+    const Table& getTable (Tier tier)
+    {
+        if (tier == Tier::automatic || ! isSupported (tier))
+            tier = getWidestSupportedTier();
+
+        return *getCompiledTable (tier);
+    }
+
+    static constexpr const char* tierNames[] = { "automatic", "scalar", "sse2", "avx2", "avx512", "neon" };
+
+    const char* getTierName (Tier tier)
+    {
+        return tierNames[static_cast<int> (tier)];
+    }
+
+    Tier getTierFromName (const char* name)
+    {
+        if (name != nullptr)
+            for (int i = 0; i < juce::numElementsInArray (tierNames); ++i)
+                if (std::strcmp (name, tierNames[i]) == 0)
+                    return static_cast<Tier> (i);
+
+        return Tier::automatic;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+//==============================================================================
+// Runtime-dispatched float kernels
+//
+// The plugin ships as a single binary built for the lowest instruction set it
+// supports, so anything wider has to be chosen at run time. The hot float
+// loops of SaturationDSP.h (the rational and low-level shapers, the packed
+// multichannel tilt filter and the output gain/mix) are compiled once per
+// instruction set, each in its own translation unit, and collected into a
+// Table of function pointers. TubeSaturation picks a Table in prepare().
+//
+// This header is included by those translation units as well, so it stays
+// free of JUCE.
+//==============================================================================
+namespace SaturationKernels
+{
+    enum class Tier
+    {
+        automatic,   // widest tier the CPU supports
+        scalar,
+        sse2,
+        avx2,
+        avx512,
+        neon
+    };
+
+    struct Table
+    {
+        Tier tier;
+
+        // In place, the same transfer functions as TubeSaturation's
+        // tubeWaveshapeRational() and tubeWaveshapeQuiet()
+        void (*shapeRational) (float* data, int numSamples);
+        void (*shapeQuiet) (float* data, int numSamples);
+
+        // TiltEQ recursion over numChannels channels at once; x1/y1 hold the
+        // per-channel filter state and a0/a1/b1 the per-sample coefficients
+        void (*tiltInterleaved) (float* const* channels, int numChannels, float* x1, float* y1,
+                                 const float* a0, const float* a1, const float* b1, int numSamples);
+
+        // out = wet * gain
+        void (*applyGain) (float* out, const float* wet, const float* gain, int numSamples);
+
+        // out = out * (1 - mix) + wet * gain * mix, where out holds the dry signal
+        void (*applyGainAndMix) (float* out, const float* wet, const float* gain, const float* mix, int numSamples);
+    };
+
+    // The kernels for `tier`, or for the widest supported tier if the CPU (or
+    // this build) cannot run it. Tier::automatic always takes the widest.
+    const Table& getTable (Tier tier);
+
+    bool isSupported (Tier tier);
+    Tier getWidestSupportedTier();
+
+    const char* getTierName (Tier tier);
+
+    // Inverse of getTierName(); unknown names map to Tier::automatic
+    Tier getTierFromName (const char* name);
+
+    // Per instruction set tables, null where the build target can't have them
+    const Table* getScalarTable();
+    const Table* getSSE2Table();
+    const Table* getAVX2Table();
+    const Table* getAVX512Table();
+    const Table* getNEONTable();
+}
@@ -0,0 +1,166 @@
+// No include guard: this file is included once per instruction set by the
+// SaturationKernels_*.cpp files, each inside its own namespace and with
+//
+//   KERNEL_TARGET  the function attribute enabling the instruction set
+//   KERNEL_TIER    the SaturationKernels::Tier being built
+//   Vec            a struct wrapping the native register, see below
+//
+// defined first. Vec provides `type`, `width`, and load/store (unaligned),
+// set, add, sub, mul, div, min, max and abs. Every kernel runs its body a
+// register at a time and the remainder through ScalarVec, with the same
+// operation order as the SIMDRegister code in SaturationDSP.h.
+
+struct ScalarVec
+{
+    using type = float;
+    static constexpr int width = 1;
+
+    static type load (const float* p)          { return *p; }
+    static void store (float* p, type x)       { *p = x; }
+    static type set (float x)                  { return x; }
+    static type add (type a, type b)           { return a + b; }
+    static type sub (type a, type b)           { return a - b; }
+    static type mul (type a, type b)           { return a * b; }
+    static type div (type a, type b)           { return a / b; }
+    static type min (type a, type b)           { return b < a ? b : a; }
+    static type max (type a, type b)           { return a < b ? b : a; }
+    static type abs (type x)                   { return x < 0 ? -x : x; }
+};
+
+//==============================================================================
+template <typename V>
+KERNEL_TARGET inline typename V::type rational (typename V::type x)
+{
+    const auto xc  = V::min (V::set (4.97f), V::max (V::set (-4.97f), x));
+    const auto xc2 = V::mul (xc, xc);
+    const auto num = V::mul (xc, V::add (V::mul (xc2, V::add (V::mul (xc2, V::add (xc2, V::set (378.0f))),
+                                                              V::set (17325.0f))),
+                                         V::set (135135.0f)));
+    const auto den = V::add (V::mul (xc2, V::add (V::mul (xc2, V::add (V::mul (xc2, V::set (28.0f)), V::set (3150.0f))),
+                                                  V::set (62370.0f))),
+                             V::set (135135.0f));
+    const auto absPlusOne = V::add (V::abs (x), V::set (1.0f));
+
+    return V::div (V::add (V::mul (num, absPlusOne), V::mul (V::mul (V::mul (x, x), den), V::set (0.15f))),
+                   V::mul (den, absPlusOne));
+}
+
+template <typename V>
+KERNEL_TARGET inline typename V::type quiet (typename V::type x)
+{
+    const auto ax = V::abs (x);
+    const auto x2 = V::mul (x, x);
+    const auto oneMinusAx = V::sub (V::set (1.0f), ax);
+    const auto bias = V::mul (V::mul (x2, V::add (oneMinusAx, V::mul (x2, oneMinusAx))), V::set (0.15f));
+
+    return V::add (V::sub (x, V::mul (V::mul (x, x2), V::set (1.0f / 3.0f))), bias);
+}
+
+//==============================================================================
+KERNEL_TARGET inline void shapeRational (float* data, int numSamples)
+{
+    int i = 0;
+
+    for (; i + Vec::width <= numSamples; i += Vec::width)
+        Vec::store (data + i, rational<Vec> (Vec::load (data + i)));
+
+    for (; i < numSamples; ++i)
+        data[i] = rational<ScalarVec> (data[i]);
+}
+
+KERNEL_TARGET inline void shapeQuiet (float* data, int numSamples)
+{
+    int i = 0;
+
+    for (; i + Vec::width <= numSamples; i += Vec::width)
+        Vec::store (data + i, quiet<Vec> (Vec::load (data + i)));
+
+    for (; i < numSamples; ++i)
+        data[i] = quiet<ScalarVec> (data[i]);
+}
+
+//==============================================================================
+// Channels are packed into registers a frame at a time, so a register as wide
+// as the bus (e.g. all twelve channels of a 7.1.4 bed under AVX-512) filters
+// every channel in one recursion.
+KERNEL_TARGET inline void tiltInterleaved (float* const* channels, int numChannels, float* x1, float* y1,
+                                           const float* a0, const float* a1, const float* b1, int numSamples)
+{
+    constexpr int width = Vec::width;
+
+    for (int first = 0; first < numChannels; first += width)
+    {
+        const int lanes = numChannels - first < width ? numChannels - first : width;
+        float* const* group = channels + first;
+
+        // Lanes past the last channel stay zero throughout
+        float in[width] = {}, out[width] = {}, state[width] = {};
+
+        for (int lane = 0; lane < lanes; ++lane)
+            state[lane] = x1[first + lane];
+        auto xPrev = Vec::load (state);
+
+        for (int lane = 0; lane < lanes; ++lane)
+            state[lane] = y1[first + lane];
+        auto yPrev = Vec::load (state);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int lane = 0; lane < lanes; ++lane)
+                in[lane] = group[lane][i];
+
+            const auto input  = Vec::load (in);
+            const auto output = Vec::sub (Vec::add (Vec::mul (input, Vec::set (a0[i])),
+                                                    Vec::mul (xPrev, Vec::set (a1[i]))),
+                                          Vec::mul (yPrev, Vec::set (b1[i])));
+            xPrev = input;
+            yPrev = output;
+
+            Vec::store (out, output);
+            for (int lane = 0; lane < lanes; ++lane)
+                group[lane][i] = out[lane];
+        }
+
+        Vec::store (state, xPrev);
+        for (int lane = 0; lane < lanes; ++lane)
+            x1[first + lane] = state[lane];
+
+        Vec::store (state, yPrev);
+        for (int lane = 0; lane < lanes; ++lane)
+            y1[first + lane] = state[lane];
+    }
+}
+
+//==============================================================================
+KERNEL_TARGET inline void applyGain (float* out, const float* wet, const float* gain, int numSamples)
+{
+    int i = 0;
+
+    for (; i + Vec::width <= numSamples; i += Vec::width)
+        Vec::store (out + i, Vec::mul (Vec::load (wet + i), Vec::load (gain + i)));
+
+    for (; i < numSamples; ++i)
+        out[i] = wet[i] * gain[i];
+}
+
+template <typename V>
+KERNEL_TARGET inline typename V::type gainAndMix (typename V::type dry, typename V::type wet,
+                                                  typename V::type gain, typename V::type mix)
+{
+    return V::add (V::mul (dry, V::sub (V::set (1.0f), mix)), V::mul (V::mul (wet, gain), mix));
+}
+
+KERNEL_TARGET inline void applyGainAndMix (float* out, const float* wet, const float* gain, const float* mix, int numSamples)
+{
+    int i = 0;
+
+    for (; i + Vec::width <= numSamples; i += Vec::width)
+        Vec::store (out + i, gainAndMix<Vec> (Vec::load (out + i), Vec::load (wet + i),
+                                              Vec::load (gain + i), Vec::load (mix + i)));
+
+    for (; i < numSamples; ++i)
+        out[i] = gainAndMix<ScalarVec> (out[i], wet[i], gain[i], mix[i]);
+}
+
+//==============================================================================
+const Table table { KERNEL_TIER, shapeRational, shapeQuiet, tiltInterleaved, applyGain, applyGainAndMix };
@@ -0,0 +1,55 @@
+#include "SaturationKernels.h"
+
+// 8-lane kernels for AVX2 CPUs
+
+#if defined (__i386__) || defined (__amd64__) || defined (_M_X64) || defined (_X86_) || defined (_M_IX86)
+ #include <immintrin.h>
+
+namespace SaturationKernels
+{
+    namespace avx2
+    {
+       #if defined (__GNUC__) || defined (__clang__)
+        #define KERNEL_TARGET __attribute__ ((target ("avx2")))
+       #else
+        #define KERNEL_TARGET
+       #endif
+        #define KERNEL_TIER Tier::avx2
+
+        struct Vec
+        {
+            using type = __m256;
+            static constexpr int width = 8;
+
+            KERNEL_TARGET static type load (const float* p)     { return _mm256_loadu_ps (p); }
+            KERNEL_TARGET static void store (float* p, type x)  { _mm256_storeu_ps (p, x); }
+            KERNEL_TARGET static type set (float x)             { return _mm256_set1_ps (x); }
+            KERNEL_TARGET static type add (type a, type b)      { return _mm256_add_ps (a, b); }
+            KERNEL_TARGET static type sub (type a, type b)      { return _mm256_sub_ps (a, b); }
+            KERNEL_TARGET static type mul (type a, type b)      { return _mm256_mul_ps (a, b); }
+            KERNEL_TARGET static type div (type a, type b)      { return _mm256_div_ps (a, b); }
+            KERNEL_TARGET static type min (type a, type b)      { return _mm256_min_ps (a, b); }
+            KERNEL_TARGET static type max (type a, type b)      { return _mm256_max_ps (a, b); }
+            KERNEL_TARGET static type abs (type x)              { return _mm256_andnot_ps (_mm256_set1_ps (-0.0f), x); }
+        };
+
+        #include "SaturationKernelsImpl.h"
+
+        #undef KERNEL_TARGET
+        #undef KERNEL_TIER
+    }
+
+    const Table* getAVX2Table()
+    {
+        return &avx2::table;
+    }
+}
+
+#else
+
+const SaturationKernels::Table* SaturationKernels::getAVX2Table()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,55 @@
+#include "SaturationKernels.h"
+
+// 16-lane kernels for AVX-512 CPUs
+
+#if defined (__i386__) || defined (__amd64__) || defined (_M_X64) || defined (_X86_) || defined (_M_IX86)
+ #include <immintrin.h>
+
+namespace SaturationKernels
+{
+    namespace avx512
+    {
+       #if defined (__GNUC__) || defined (__clang__)
+        #define KERNEL_TARGET __attribute__ ((target ("avx512f")))
+       #else
+        #define KERNEL_TARGET
+       #endif
+        #define KERNEL_TIER Tier::avx512
+
+        struct Vec
+        {
+            using type = __m512;
+            static constexpr int width = 16;
+
+            KERNEL_TARGET static type load (const float* p)     { return _mm512_loadu_ps (p); }
+            KERNEL_TARGET static void store (float* p, type x)  { _mm512_storeu_ps (p, x); }
+            KERNEL_TARGET static type set (float x)             { return _mm512_set1_ps (x); }
+            KERNEL_TARGET static type add (type a, type b)      { return _mm512_add_ps (a, b); }
+            KERNEL_TARGET static type sub (type a, type b)      { return _mm512_sub_ps (a, b); }
+            KERNEL_TARGET static type mul (type a, type b)      { return _mm512_mul_ps (a, b); }
+            KERNEL_TARGET static type div (type a, type b)      { return _mm512_div_ps (a, b); }
+            KERNEL_TARGET static type min (type a, type b)      { return _mm512_min_ps (a, b); }
+            KERNEL_TARGET static type max (type a, type b)      { return _mm512_max_ps (a, b); }
+            KERNEL_TARGET static type abs (type x)              { return _mm512_abs_ps (x); }
+        };
+
+        #include "SaturationKernelsImpl.h"
+
+        #undef KERNEL_TARGET
+        #undef KERNEL_TIER
+    }
+
+    const Table* getAVX512Table()
+    {
+        return &avx512::table;
+    }
+}
+
+#else
+
+const SaturationKernels::Table* SaturationKernels::getAVX512Table()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,52 @@
+#include "SaturationKernels.h"
+
+// 4-lane kernels for Apple silicon and other AArch64 CPUs
+
+#if defined (__aarch64__) || defined (_M_ARM64)
+ #include <arm_neon.h>
+
+namespace SaturationKernels
+{
+    namespace neon
+    {
+        // NEON is part of the AArch64 baseline, no attribute needed
+        #define KERNEL_TARGET
+        #define KERNEL_TIER Tier::neon
+
+        struct Vec
+        {
+            using type = float32x4_t;
+            static constexpr int width = 4;
+
+            static type load (const float* p)     { return vld1q_f32 (p); }
+            static void store (float* p, type x)  { vst1q_f32 (p, x); }
+            static type set (float x)             { return vdupq_n_f32 (x); }
+            static type add (type a, type b)      { return vaddq_f32 (a, b); }
+            static type sub (type a, type b)      { return vsubq_f32 (a, b); }
+            static type mul (type a, type b)      { return vmulq_f32 (a, b); }
+            static type div (type a, type b)      { return vdivq_f32 (a, b); }
+            static type min (type a, type b)      { return vminq_f32 (a, b); }
+            static type max (type a, type b)      { return vmaxq_f32 (a, b); }
+            static type abs (type x)              { return vabsq_f32 (x); }
+        };
+
+        #include "SaturationKernelsImpl.h"
+
+        #undef KERNEL_TARGET
+        #undef KERNEL_TIER
+    }
+
+    const Table* getNEONTable()
+    {
+        return &neon::table;
+    }
+}
+
+#else
+
+const SaturationKernels::Table* SaturationKernels::getNEONTable()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,55 @@
+#include "SaturationKernels.h"
+
+// 4-lane kernels, available on every x86 CPU the plugin runs on
+
+#if defined (__i386__) || defined (__amd64__) || defined (_M_X64) || defined (_X86_) || defined (_M_IX86)
+ #include <immintrin.h>
+
+namespace SaturationKernels
+{
+    namespace sse2
+    {
+       #if defined (__GNUC__) || defined (__clang__)
+        #define KERNEL_TARGET __attribute__ ((target ("sse2")))
+       #else
+        #define KERNEL_TARGET
+       #endif
+        #define KERNEL_TIER Tier::sse2
+
+        struct Vec
+        {
+            using type = __m128;
+            static constexpr int width = 4;
+
+            KERNEL_TARGET static type load (const float* p)     { return _mm_loadu_ps (p); }
+            KERNEL_TARGET static void store (float* p, type x)  { _mm_storeu_ps (p, x); }
+            KERNEL_TARGET static type set (float x)             { return _mm_set1_ps (x); }
+            KERNEL_TARGET static type add (type a, type b)      { return _mm_add_ps (a, b); }
+            KERNEL_TARGET static type sub (type a, type b)      { return _mm_sub_ps (a, b); }
+            KERNEL_TARGET static type mul (type a, type b)      { return _mm_mul_ps (a, b); }
+            KERNEL_TARGET static type div (type a, type b)      { return _mm_div_ps (a, b); }
+            KERNEL_TARGET static type min (type a, type b)      { return _mm_min_ps (a, b); }
+            KERNEL_TARGET static type max (type a, type b)      { return _mm_max_ps (a, b); }
+            KERNEL_TARGET static type abs (type x)              { return _mm_andnot_ps (_mm_set1_ps (-0.0f), x); }
+        };
+
+        #include "SaturationKernelsImpl.h"
+
+        #undef KERNEL_TARGET
+        #undef KERNEL_TIER
+    }
+
+    const Table* getSSE2Table()
+    {
+        return &sse2::table;
+    }
+}
+
+#else
+
+const SaturationKernels::Table* SaturationKernels::getSSE2Table()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,26 @@
+#include "SaturationKernels.h"
+
+// Portable fallback, and the reference the wider tiers are compared against
+
+namespace SaturationKernels
+{
+    namespace scalar
+    {
+        #define KERNEL_TARGET
+        #define KERNEL_TIER Tier::scalar
+
+        // ScalarVec is defined by the shared implementation itself
+        struct ScalarVec;
+        using Vec = ScalarVec;
+
+        #include "SaturationKernelsImpl.h"
+
+        #undef KERNEL_TARGET
+        #undef KERNEL_TIER
+    }
+
+    const Table* getScalarTable()
+    {
+        return &scalar::table;
+    }
+}
@@ -0,0 +1,286 @@
+#include <JuceHeader.h>
+#include "SaturationDSP.h"
+
+#include <iostream>
+
+//==============================================================================
+// Aliasing vs. CPU analysis
+//
+// Sweeps sine tones through TubeSaturation at several drive levels in every
+// anti-aliasing configuration: the plain exact, rational and lookup-table
+// shapers, the two ADAA shapers, and the rational shaper at each
+// oversampling factor with each filter. For every run it measures
+//
+//   aliasing_db    energy outside the harmonic bins of a windowed FFT of the
+//                  output, relative to the total output energy (dBc). The
+//                  tone sits exactly on a bin, so every harmonic below
+//                  Nyquist lands on a known bin and anything else is folded
+//                  harmonics, i.e. aliasing.
+//   ns_per_sample  wall time per sample to process the same tone
+//
+// and prints one CSV row per run. A summary goes to stderr: per
+// configuration, the worst aliasing over all tones and drives against the
+// mean cost, with the configurations no other one beats on both marked as
+// Pareto-optimal.
+//
+//   AliasingAnalysis [--out=aliasing.csv] [--sample-rate=48000] [--fft-order=16]
+//==============================================================================
+namespace
+{
+    using Saturation = TubeSaturation<float>;
+
+    struct Configuration
+    {
+        juce::String name;
+        Saturation::ShaperMode shaper;
+        int oversamplingOrder;
+        Saturation::OversamplingFilter filter;
+    };
+
+    struct Measurement
+    {
+        double aliasingDb = 0;
+        double nsPerSample = 0;
+        int latencySamples = 0;
+    };
+
+    const double toneFrequencies[] = { 1000.0, 2500.0, 5000.0, 8000.0, 12000.0, 16000.0 };
+    const float driveLevels[]      = { 6.0f, 20.0f, 40.0f };
+
+    constexpr int blockSize = 512;
+
+    // Half-width of a Blackman-Harris main lobe, in bins
+    constexpr int lobeBins = 4;
+
+    std::vector<Configuration> makeConfigurations()
+    {
+        using Mode = Saturation::ShaperMode;
+        using Filter = Saturation::OversamplingFilter;
+
+        std::vector<Configuration> configurations {
+            { "exact",    Mode::exact,    0, Filter::polyphaseIIR },
+            { "rational", Mode::rational, 0, Filter::polyphaseIIR },
+            { "table",    Mode::table,    0, Filter::polyphaseIIR },
+            { "adaa1",    Mode::adaa1,    0, Filter::polyphaseIIR },
+            { "adaa2",    Mode::adaa2,    0, Filter::polyphaseIIR }
+        };
+
+        for (auto filter : { Filter::polyphaseIIR, Filter::halfBandFIR })
+            for (int order = 1; order <= Saturation::maxOversamplingOrder; ++order)
+                configurations.push_back ({ "rational " + juce::String (1 << order) + "x "
+                                                + (filter == Filter::polyphaseIIR ? "iir" : "fir"),
+                                            Mode::rational, order, filter });
+
+        return configurations;
+    }
+
+    //==========================================================================
+    // Analyses fftSize samples of settled output for one tone: the tone runs
+    // through one FFT length first so the oversampling filters and ramps
+    // have settled. The same tone is then processed for about a second of
+    // audio to time it, since one FFT length is too short to time reliably.
+    Measurement measure (const Configuration& configuration, double sampleRate, float driveDb,
+                         int toneBin, const juce::dsp::FFT& fft,
+                         const juce::dsp::WindowingFunction<float>& window)
+    {
+        const int fftSize = fft.getSize();
+
+        Saturation saturation;
+        saturation.setShaperMode (configuration.shaper);
+        saturation.setDrive (driveDb);
+        saturation.setOversampling (configuration.oversamplingOrder, configuration.filter);
+        saturation.prepare ({ sampleRate, static_cast<juce::uint32> (blockSize), 1 });
+
+        // Coherent tone, a whole number of cycles per FFT length
+        std::vector<float> tone (static_cast<size_t> (fftSize));
+        const double phaseStep = juce::MathConstants<double>::twoPi * toneBin / fftSize;
+
+        for (size_t i = 0; i < tone.size(); ++i)
+            tone[i] = static_cast<float> (0.5 * std::sin (phaseStep * static_cast<double> (i)));
+
+        std::vector<float> signal (tone);
+
+        juce::AudioBuffer<float> block (1, blockSize);
+
+        auto run = [&] (float* data, int numSamples)
+        {
+            for (int start = 0; start < numSamples; start += blockSize)
+            {
+                const int length = juce::jmin (blockSize, numSamples - start);
+                juce::AudioBuffer<float> chunk (block.getArrayOfWritePointers(), 1, length);
+
+                chunk.copyFrom (0, 0, data + start, length);
+                saturation.process (chunk);
+                juce::FloatVectorOperations::copy (data + start, chunk.getReadPointer (0), length);
+            }
+        };
+
+        run (signal.data(), fftSize);
+
+        signal = tone;
+        run (signal.data(), fftSize);
+
+        // performFrequencyOnlyForwardTransform() needs twice the FFT size
+        std::vector<float> spectrum (static_cast<size_t> (2 * fftSize), 0.0f);
+        std::copy (signal.begin(), signal.end(), spectrum.begin());
+        window.multiplyWithWindowingTable (spectrum.data(), static_cast<size_t> (fftSize));
+        fft.performFrequencyOnlyForwardTransform (spectrum.data(), true);
+
+        // Harmonic bins: DC (the shaper is asymmetric) and every multiple of
+        // the tone below Nyquist, each with its window main lobe
+        const int nyquistBin = fftSize / 2;
+        std::vector<bool> harmonic (static_cast<size_t> (nyquistBin + 1), false);
+
+        for (int centre = 0; centre <= nyquistBin; centre += toneBin)
+            for (int bin = juce::jmax (0, centre - lobeBins); bin <= juce::jmin (nyquistBin, centre + lobeBins); ++bin)
+                harmonic[static_cast<size_t> (bin)] = true;
+
+        double total = 0, aliased = 0;
+
+        for (int bin = 0; bin <= nyquistBin; ++bin)
+        {
+            const double power = static_cast<double> (spectrum[static_cast<size_t> (bin)])
+                               * static_cast<double> (spectrum[static_cast<size_t> (bin)]);
+            total += power;
+
+            if (! harmonic[static_cast<size_t> (bin)])
+                aliased += power;
+        }
+
+        // Refilling from the tone (a memcpy) is included in the time
+        const int passes = juce::jmax (1, juce::roundToInt (sampleRate / fftSize));
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            std::copy (tone.begin(), tone.end(), signal.begin());
+            run (signal.data(), fftSize);
+        }
+
+        const auto elapsed = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTicks);
+
+        Measurement m;
+        m.aliasingDb = 10.0 * std::log10 (juce::jmax (aliased, 1.0e-30) / juce::jmax (total, 1.0e-30));
+        m.nsPerSample = elapsed * 1.0e9 / (static_cast<double> (passes) * fftSize);
+        m.latencySamples = saturation.getLatencySamples();
+        return m;
+    }
+
+    // An odd bin is coprime with the power-of-two FFT size, so a harmonic
+    // has to fold back toneBin times before it lands on a harmonic bin
+    int getToneBin (double frequency, double sampleRate, int fftSize)
+    {
+        const int bin = juce::roundToInt (frequency * fftSize / sampleRate);
+        return bin | 1;
+    }
+
+    //==========================================================================
+    struct Summary
+    {
+        juce::String name;
+        double worstAliasingDb = -1000.0;
+        double totalNs = 0;
+        int runs = 0;
+
+        double getMeanNs() const { return totalNs / juce::jmax (1, runs); }
+    };
+
+    void printSummary (const std::vector<Summary>& summaries)
+    {
+        std::cerr << "configuration, worst aliasing dB, mean ns/sample, pareto" << std::endl;
+
+        for (const auto& s : summaries)
+        {
+            const bool dominated = std::any_of (summaries.begin(), summaries.end(), [&] (const Summary& other)
+            {
+                return &other != &s
+                    && other.worstAliasingDb <= s.worstAliasingDb && other.getMeanNs() <= s.getMeanNs()
+                    && (other.worstAliasingDb < s.worstAliasingDb || other.getMeanNs() < s.getMeanNs());
+            });
+
+            std::cerr << s.name << ", " << juce::String (s.worstAliasingDb, 1) << ", "
+                      << juce::String (s.getMeanNs(), 2) << ", " << (dominated ? "" : "*") << std::endl;
+        }
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    const juce::ArgumentList args (argc, argv);
+    const juce::ScopedNoDenormals noDenormals;
+
+    const double sampleRate = args.containsOption ("--sample-rate")
+                                ? args.getValueForOption ("--sample-rate").getDoubleValue()
+                                : 48000.0;
+
+    const int fftOrder = args.containsOption ("--fft-order")
+                           ? juce::jlimit (10, 20, args.getValueForOption ("--fft-order").getIntValue())
+                           : 16;
+
+    const juce::dsp::FFT fft (fftOrder);
+    const juce::dsp::WindowingFunction<float> window (static_cast<size_t> (fft.getSize()),
+                                                      juce::dsp::WindowingFunction<float>::blackmanHarris,
+                                                      false);
+
+    juce::String csv = "configuration,shaper,oversampling,filter,drive_db,frequency_hz,aliasing_db,ns_per_sample,latency_samples\n";
+    std::vector<Summary> summaries;
+
+    for (const auto& configuration : makeConfigurations())
+    {
+        Summary summary;
+        summary.name = configuration.name;
+
+        for (auto drive : driveLevels)
+        {
+            for (auto frequency : toneFrequencies)
+            {
+                if (frequency >= sampleRate * 0.45)
+                    continue;
+
+                const int toneBin = getToneBin (frequency, sampleRate, fft.getSize());
+                const double actualFrequency = toneBin * sampleRate / fft.getSize();
+                const auto m = measure (configuration, sampleRate, drive, toneBin, fft, window);
+
+                summary.worstAliasingDb = juce::jmax (summary.worstAliasingDb, m.aliasingDb);
+                summary.totalNs += m.nsPerSample;
+                ++summary.runs;
+
+                csv << configuration.name << ','
+                    << (configuration.shaper == Saturation::ShaperMode::exact ? "exact"
+                        : configuration.shaper == Saturation::ShaperMode::adaa1 ? "adaa1"
+                        : configuration.shaper == Saturation::ShaperMode::adaa2 ? "adaa2"
+                        : configuration.shaper == Saturation::ShaperMode::table ? "table" : "rational") << ','
+                    << (1 << configuration.oversamplingOrder) << ','
+                    << (configuration.filter == Saturation::OversamplingFilter::polyphaseIIR ? "iir" : "fir") << ','
+                    << juce::String (drive, 1) << ','
+                    << juce::String (actualFrequency, 1) << ','
+                    << juce::String (m.aliasingDb, 2) << ','
+                    << juce::String (m.nsPerSample, 3) << ','
+                    << m.latencySamples << '\n';
+            }
+        }
+
+        std::cerr << "." << std::flush;
+        summaries.push_back (summary);
+    }
+
+    std::cerr << std::endl;
+    printSummary (summaries);
+
+    if (! args.containsOption ("--out"))
+    {
+        std::cout << csv;
+        return 0;
+    }
+
+    const auto file = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--out"));
+
+    if (! file.replaceWithText (csv))
+    {
+        std::cerr << "Could not write " << file.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,760 @@
+#include <JuceHeader.h>
+#include "SaturationDSP.h"
+
+#include <iostream>
+
+//==============================================================================
+// DSP benchmark
+//
+// Times TubeSaturation::process() and TiltEQ::processSample() over a matrix
+// of sample rates, block sizes, channel counts, drive levels and mix states,
+// then every shaper mode side by side at one typical setting. The lookup
+// table cases also report the table's error against the exact curve over
+// the input range their drive reaches (max_abs_error, rms_error).
+// Each case processes `seconds` of a pre-rendered input, block by block as a
+// host would, `repetitions` times; the median run is reported, the fastest
+// alongside it.
+//
+//   ns_per_sample    wall time per sample per channel
+//   realtime_factor  audio time processed per second of wall time, i.e. how
+//                    many instances of this case one core could run
+//
+// Results are written as JSON in Google Benchmark's layout (a "context"
+// object and a "benchmarks" array), so its compare scripts can diff runs.
+//
+// With --verify nothing is timed; instead the vectorised paths are checked
+// against per-sample scalar references (see runVerification()), and the
+// exit code is non-zero if any is out of bounds.
+//
+//   DSPBenchmark [--out=results.json] [--seconds=0.5] [--repetitions=5]
+//                [--tier=avx2] [--filter=TubeSaturation/sr:48000] [--verify]
+//==============================================================================
+namespace
+{
+    struct Options
+    {
+        juce::File output;
+        double seconds = 0.5;
+        int repetitions = 5;
+        SaturationKernels::Tier tier = SaturationKernels::Tier::automatic;
+        juce::String filter;
+    };
+
+    struct Case
+    {
+        double sampleRate;
+        int blockSize;
+        int channels;
+        float driveDb;
+        float mix;
+    };
+
+    struct Timing
+    {
+        juce::int64 blocks = 0;
+        double medianSeconds = 0;
+        double fastestSeconds = 0;
+    };
+
+    const double sampleRates[] = { 44100.0, 48000.0, 96000.0 };
+    const int blockSizes[]     = { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    const int channelCounts[]  = { 1, 2, 6, 12 };
+    const float driveLevels[]  = { 0.0f, 12.0f, 40.0f };
+    const float mixLevels[]    = { 1.0f, 0.5f, 0.0f };
+
+    using Interpolation = WaveshaperTable<float>::Interpolation;
+
+    struct Shaper
+    {
+        const char* name;
+        TubeShaperMode mode;
+        Interpolation interpolation;
+    };
+
+    const Shaper rationalShaper { "rational", TubeShaperMode::rational, Interpolation::cubic };
+
+    const Shaper shapers[] = { { "exact",        TubeShaperMode::exact,  Interpolation::cubic },
+                               rationalShaper,
+                               { "table-linear", TubeShaperMode::table,  Interpolation::linear },
+                               { "table-cubic",  TubeShaperMode::table,  Interpolation::cubic },
+                               { "adaa1",        TubeShaperMode::adaa1,  Interpolation::cubic },
+                               { "adaa2",        TubeShaperMode::adaa2,  Interpolation::cubic } };
+
+    juce::String getMixName (float mix)
+    {
+        if (mix >= 1.0f)  return "wet";
+        if (mix <= 0.0f)  return "bypass";
+        return "blend";
+    }
+
+    //==========================================================================
+    // One second of programme-like input: two unrelated partials per channel
+    // plus a little noise, peaking around -6dBFS, so the shaper sees loud and
+    // quiet passages alike. Seeded, so every run times the same signal.
+    juce::AudioBuffer<float> makeInput (double sampleRate, int channels)
+    {
+        const int length = static_cast<int> (sampleRate);
+        juce::AudioBuffer<float> input (channels, length);
+        juce::Random random (0x5a7);
+
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            auto* data = input.getWritePointer (ch);
+            const double f1 = 110.0 * (ch + 1);
+            const double f2 = 1870.0 + 37.0 * ch;
+
+            for (int i = 0; i < length; ++i)
+            {
+                const double t = i / sampleRate;
+                const double envelope = 0.5 + 0.5 * std::sin (juce::MathConstants<double>::twoPi * 0.5 * t);
+                data[i] = static_cast<float> (envelope * (0.35 * std::sin (juce::MathConstants<double>::twoPi * f1 * t)
+                                                          + 0.12 * std::sin (juce::MathConstants<double>::twoPi * f2 * t))
+                                              + 0.01 * (random.nextDouble() * 2.0 - 1.0));
+            }
+        }
+
+        return input;
+    }
+
+    // Runs `processBlock` over `seconds` of audio per repetition, after one
+    // untimed pass to settle caches, ramps and branch predictors. Refilling
+    // each block from the input (a memcpy) is included in the time.
+    template <typename ProcessBlock>
+    Timing measure (const juce::AudioBuffer<float>& input, int blockSize, double seconds,
+                    int repetitions, ProcessBlock&& processBlock)
+    {
+        const int channels = input.getNumChannels();
+        const int inputLength = input.getNumSamples() - input.getNumSamples() % blockSize;
+        const auto totalSamples = static_cast<juce::int64> (seconds * input.getNumSamples());
+
+        Timing timing;
+        timing.blocks = juce::jmax<juce::int64> (1, totalSamples / blockSize);
+
+        juce::AudioBuffer<float> block (channels, blockSize);
+        int position = 0;
+
+        auto runOnce = [&]
+        {
+            for (juce::int64 b = 0; b < timing.blocks; ++b)
+            {
+                for (int ch = 0; ch < channels; ++ch)
+                    block.copyFrom (ch, 0, input, ch, position, blockSize);
+
+                processBlock (block);
+
+                position += blockSize;
+                if (position >= inputLength)
+                    position = 0;
+            }
+        };
+
+        runOnce();
+
+        std::vector<double> runs;
+        for (int r = 0; r < repetitions; ++r)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            runOnce();
+            runs.push_back (juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start));
+        }
+
+        std::sort (runs.begin(), runs.end());
+        timing.medianSeconds = runs[runs.size() / 2];
+        timing.fastestSeconds = runs.front();
+        return timing;
+    }
+
+    juce::var makeResult (const juce::String& name, const Case& c, const Timing& timing, int repetitions)
+    {
+        const double channelSamples = static_cast<double> (timing.blocks) * c.blockSize * c.channels;
+        const double audioSeconds = static_cast<double> (timing.blocks) * c.blockSize / c.sampleRate;
+        const double nsPerBlock = timing.medianSeconds * 1.0e9 / static_cast<double> (timing.blocks);
+
+        auto* result = new juce::DynamicObject();
+        result->setProperty ("name", name);
+        result->setProperty ("run_name", name);
+        result->setProperty ("run_type", "iteration");
+        result->setProperty ("repetitions", repetitions);
+        result->setProperty ("iterations", timing.blocks);
+        result->setProperty ("real_time", nsPerBlock);
+        result->setProperty ("cpu_time", nsPerBlock);
+        result->setProperty ("time_unit", "ns");
+        result->setProperty ("sample_rate", c.sampleRate);
+        result->setProperty ("block_size", c.blockSize);
+        result->setProperty ("channels", c.channels);
+        result->setProperty ("drive_db", c.driveDb);
+        result->setProperty ("mix", c.mix);
+        result->setProperty ("ns_per_sample", timing.medianSeconds * 1.0e9 / channelSamples);
+        result->setProperty ("ns_per_sample_fastest", timing.fastestSeconds * 1.0e9 / channelSamples);
+        result->setProperty ("realtime_factor", audioSeconds / timing.medianSeconds);
+        return juce::var (result);
+    }
+
+    void report (const juce::var& result)
+    {
+        std::cerr << result["name"].toString() << "  "
+                  << juce::String (static_cast<double> (result["ns_per_sample"]), 3) << " ns/sample  "
+                  << juce::String (static_cast<double> (result["realtime_factor"]), 1) << "x realtime";
+
+        if (result.hasProperty ("max_abs_error"))
+            std::cerr << "  max error " << static_cast<double> (result["max_abs_error"]);
+
+        std::cerr << std::endl;
+    }
+
+    //==========================================================================
+    juce::var benchmarkTubeSaturation (const Case& c, const Shaper& shaper, const juce::AudioBuffer<float>& input,
+                                       const Options& options, const juce::String& name)
+    {
+        TubeSaturation<float> saturation;
+        saturation.setKernelTier (options.tier);
+        saturation.setShaperMode (shaper.mode);
+        saturation.setLookupTableInterpolation (shaper.interpolation);
+        saturation.setDrive (c.driveDb);
+        saturation.setMix (c.mix);
+        saturation.setTone (0.3f);
+        saturation.prepare ({ c.sampleRate, static_cast<juce::uint32> (c.blockSize),
+                              static_cast<juce::uint32> (c.channels) });
+
+        const auto timing = measure (input, c.blockSize, options.seconds, options.repetitions,
+                                     [&] (juce::AudioBuffer<float>& block) { saturation.process (block); });
+
+        auto result = makeResult (name, c, timing, options.repetitions);
+
+        if (shaper.mode == TubeShaperMode::table)
+        {
+            const auto accuracy = saturation.getLookupTableAccuracy();
+            result.getDynamicObject()->setProperty ("max_abs_error", accuracy.maxAbsError);
+            result.getDynamicObject()->setProperty ("rms_error", accuracy.rmsError);
+        }
+
+        return result;
+    }
+
+    juce::var benchmarkTiltEQ (const Case& c, const juce::AudioBuffer<float>& input,
+                               const Options& options, const juce::String& name)
+    {
+        TiltEQ<float> tilt;
+        tilt.prepare (c.sampleRate, c.channels, c.blockSize);
+        tilt.setTilt (0.3f);
+
+        const auto timing = measure (input, c.blockSize, options.seconds, options.repetitions,
+                                     [&] (juce::AudioBuffer<float>& block)
+                                     {
+                                         const int numSamples = block.getNumSamples();
+                                         tilt.beginBlock (numSamples);
+
+                                         for (int ch = 0; ch < block.getNumChannels(); ++ch)
+                                         {
+                                             auto* data = block.getWritePointer (ch);
+
+                                             for (int i = 0; i < numSamples; ++i)
+                                                 data[i] = tilt.processSample (ch, i, data[i]);
+                                         }
+                                     });
+
+        return makeResult (name, c, timing, options.repetitions);
+    }
+
+    //==========================================================================
+    // --verify: the vectorised paths against per-sample scalar references.
+    //
+    // Random blocks of random length, each filled with one kind of input:
+    // noise at several levels, silence, denormals, impulses, full-scale DC
+    // and large values (up to 1e6, which stays clear of overflow at full
+    // drive), with the parameters moved every few blocks. An output passes
+    // if it is within
+    //
+    //   absoluteBound + relativeBound * scale
+    //
+    // of the reference, where scale is the recent peak level: recursion
+    // rounding follows the level of the filter state, not of the sample.
+    // The absolute part is the quiet-series error (see
+    // TubeSaturation::processShaperSample) carried through the tilt and
+    // output gains; the relative part allows for reassociated sums and FMA.
+    //==========================================================================
+    template <typename SampleType>
+    struct Bounds
+    {
+        static constexpr double absolute = 5.0e-6;
+        static constexpr double relative = std::is_same_v<SampleType, float> ? 1.0e-5 : 1.0e-12;
+    };
+
+    struct CheckResult
+    {
+        juce::String name;
+        double maxError = 0;    // largest absolute difference
+        double worstRatio = 0;  // largest difference over its bound; > 1 fails
+
+        bool passed() const { return worstRatio <= 1.0; }
+    };
+
+    // Recent peak, decaying about as slowly as the slowest tilt pole
+    struct Scale
+    {
+        void update (double blockPeak, int numSamples)
+        {
+            value = juce::jmax (blockPeak, value * std::pow (0.999, numSamples));
+        }
+
+        double value = 0;
+    };
+
+    template <typename SampleType>
+    void compare (CheckResult& result, const SampleType* actual, const SampleType* expected,
+                  int numSamples, double scale)
+    {
+        const double bound = Bounds<SampleType>::absolute + Bounds<SampleType>::relative * scale;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double error = std::abs (static_cast<double> (actual[i]) - static_cast<double> (expected[i]));
+            result.maxError = juce::jmax (result.maxError, error);
+            result.worstRatio = juce::jmax (result.worstRatio, std::isfinite (error) ? error / bound : 1.0e30);
+        }
+    }
+
+    template <typename SampleType>
+    void fillEdgeCase (SampleType* data, int numSamples, juce::Random& random)
+    {
+        const SampleType tiny = std::numeric_limits<SampleType>::denorm_min() * 64;
+        const int kind = random.nextInt (8);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto noise = static_cast<SampleType> (random.nextDouble() * 2.0 - 1.0);
+
+            switch (kind)
+            {
+                case 0:  data[i] = noise; break;
+                case 1:  data[i] = noise * static_cast<SampleType> (0.05); break;  // quiet series
+                case 2:  data[i] = 0; break;
+                case 3:  data[i] = noise * tiny; break;
+                case 4:  data[i] = i % 37 == 0 ? 1 : 0; break;
+                case 5:  data[i] = 1; break;
+                case 6:  data[i] = noise * static_cast<SampleType> (1.0e6); break;
+                default: data[i] = random.nextInt (50) == 0 ? noise * static_cast<SampleType> (1.0e4) : noise; break;
+            }
+        }
+    }
+
+    template <typename SampleType>
+    double getPeak (const SampleType* data, int numSamples)
+    {
+        double peak = 0;
+        for (int i = 0; i < numSamples; ++i)
+            peak = juce::jmax (peak, std::abs (static_cast<double> (data[i])));
+        return peak;
+    }
+
+    template <typename SampleType>
+    double getPeak (const juce::AudioBuffer<SampleType>& buffer)
+    {
+        double peak = 0;
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            peak = juce::jmax (peak, getPeak (buffer.getReadPointer (ch), buffer.getNumSamples()));
+        return peak;
+    }
+
+    //==========================================================================
+    // TiltEQ::processBlock (mono scan, interleaved channels, per-sample
+    // coefficient ramps while the tilt moves) against processSample(), with
+    // channel pointers offset from SIMD alignment
+    template <typename SampleType>
+    CheckResult verifyTiltEQ (int channels, SaturationKernels::Tier tier, juce::Random& random)
+    {
+        constexpr int maxBlock = 512;
+        constexpr int padding = 8;
+
+        CheckResult result;
+        result.name = juce::String ("TiltEQ/")
+                    + (std::is_same_v<SampleType, float> ? juce::String ("float/tier:") + SaturationKernels::getTierName (SaturationKernels::getTable (tier).tier)
+                                                         : juce::String ("double"))
+                    + "/ch:" + juce::String (channels);
+
+        TiltEQ<SampleType> block, reference;
+        block.prepare (48000.0, channels, maxBlock);
+        block.setKernels (SaturationKernels::getTable (tier));
+        reference.prepare (48000.0, channels, maxBlock);
+
+        juce::AudioBuffer<SampleType> input (channels, maxBlock + padding), expected (channels, maxBlock);
+        std::vector<SampleType*> pointers (static_cast<size_t> (channels));
+        Scale scale;
+
+        for (int b = 0; b < 400; ++b)
+        {
+            if (b % 5 == 0)
+            {
+                const auto tilt = static_cast<SampleType> (random.nextDouble() * 2.0 - 1.0);
+                block.setTilt (tilt);
+                reference.setTilt (tilt);
+            }
+
+            const int numSamples = 1 + random.nextInt (maxBlock);
+            const int offset = random.nextInt (padding);
+
+            block.beginBlock (numSamples);
+            reference.beginBlock (numSamples);
+
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                auto* data = input.getWritePointer (ch, offset);
+                fillEdgeCase (data, numSamples, random);
+                pointers[static_cast<size_t> (ch)] = data;
+
+                auto* out = expected.getWritePointer (ch);
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = reference.processSample (ch, i, data[i]);
+            }
+
+            double peak = 0;
+            for (int ch = 0; ch < channels; ++ch)
+                peak = juce::jmax (peak, getPeak (pointers[static_cast<size_t> (ch)], numSamples),
+                                   getPeak (expected.getReadPointer (ch), numSamples));
+            scale.update (peak, numSamples);
+
+            block.processBlock (pointers.data(), channels, 0, numSamples);
+
+            for (int ch = 0; ch < channels; ++ch)
+                compare (result, pointers[static_cast<size_t> (ch)], expected.getReadPointer (ch), numSamples, scale.value);
+        }
+
+        return result;
+    }
+
+    //==========================================================================
+    // The shaper kernels, every sample against processShaperSample(). Each
+    // block is either all below the quiet threshold or straddles it, as
+    // shapeBlock() picks the path per block.
+    CheckResult verifyShaperKernels (SaturationKernels::Tier tier, juce::Random& random)
+    {
+        const auto& kernels = SaturationKernels::getTable (tier);
+
+        CheckResult result;
+        result.name = juce::String ("shaper/float/tier:") + SaturationKernels::getTierName (kernels.tier);
+
+        std::vector<float> data (520), expected (520);
+
+        for (int b = 0; b < 400; ++b)
+        {
+            const int numSamples = 1 + random.nextInt (512);
+            const int offset = random.nextInt (8);
+            auto* x = data.data() + offset;
+            fillEdgeCase (x, numSamples, random);
+
+            const bool quiet = b % 2 == 0;
+            if (quiet)
+                for (int i = 0; i < numSamples; ++i)
+                    x[i] = juce::jlimit (-0.09f, 0.09f, x[i]);
+
+            for (int i = 0; i < numSamples; ++i)
+                expected[static_cast<size_t> (i)] = TubeSaturation<float>::processShaperSample (x[i]);
+
+            const double peak = getPeak (expected.data(), numSamples);
+
+            if (quiet)
+                kernels.shapeQuiet (x, numSamples);
+            else
+                kernels.shapeRational (x, numSamples);
+
+            compare (result, x, expected.data(), numSamples, peak);
+        }
+
+        return result;
+    }
+
+    //==========================================================================
+    // The whole engine against a per-sample chain built from the scalar
+    // pieces: the same ramps, processShaperSample() and TiltEQ::processSample()
+    template <typename SampleType>
+    struct ReferenceChain
+    {
+        void prepare (double sampleRate, int channels, int maxBlock)
+        {
+            tilt.prepare (sampleRate, channels, maxBlock);
+            preGain.reset (sampleRate);
+            postGain.reset (sampleRate);
+            mix.reset (sampleRate);
+        }
+
+        void process (juce::AudioBuffer<SampleType>& buffer)
+        {
+            const int numSamples = buffer.getNumSamples();
+            preGain.applyPendingTarget (numSamples);
+            postGain.applyPendingTarget (numSamples);
+            mix.applyPendingTarget (numSamples);
+            tilt.beginBlock (numSamples);
+
+            pre.resize (static_cast<size_t> (numSamples));
+            post.resize (static_cast<size_t> (numSamples));
+            wet.resize (static_cast<size_t> (numSamples));
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                pre[static_cast<size_t> (i)] = preGain.getNextValue();
+                post[static_cast<size_t> (i)] = postGain.getNextValue();
+                wet[static_cast<size_t> (i)] = mix.getNextValue();
+            }
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                auto* data = buffer.getWritePointer (ch);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const auto n = static_cast<size_t> (i);
+                    const SampleType shaped = TubeSaturation<SampleType>::processShaperSample (data[i] * pre[n]);
+                    const SampleType y = tilt.processSample (ch, i, shaped) * post[n];
+                    data[i] = data[i] * (1 - wet[n]) + y * wet[n];
+                }
+            }
+        }
+
+        TiltEQ<SampleType> tilt;
+        ParameterRamp<SampleType> preGain { 1 }, postGain { 1 }, mix { 1 };
+        std::vector<SampleType> pre, post, wet;
+    };
+
+    template <typename SampleType>
+    CheckResult verifyEngine (int channels, SaturationKernels::Tier tier, juce::Random& random)
+    {
+        constexpr int maxBlock = 512;
+
+        CheckResult result;
+        result.name = juce::String ("TubeSaturation/")
+                    + (std::is_same_v<SampleType, float> ? juce::String ("float/tier:") + SaturationKernels::getTierName (SaturationKernels::getTable (tier).tier)
+                                                         : juce::String ("double"))
+                    + "/ch:" + juce::String (channels);
+
+        TubeSaturation<SampleType> engine;
+        engine.setKernelTier (tier);
+        engine.prepare ({ 48000.0, static_cast<juce::uint32> (maxBlock), static_cast<juce::uint32> (channels) });
+
+        ReferenceChain<SampleType> reference;
+        reference.prepare (48000.0, channels, maxBlock);
+
+        juce::AudioBuffer<SampleType> actual (channels, maxBlock), expected (channels, maxBlock);
+        Scale scale;
+
+        for (int b = 0; b < 400; ++b)
+        {
+            // Mix stays above zero: bypass resets the wet path, which the
+            // reference has no notion of
+            if (b % 7 == 0)
+            {
+                const auto drive = static_cast<SampleType> (random.nextDouble() * 40.0);
+                const auto output = static_cast<SampleType> (random.nextDouble() * 30.0 - 24.0);
+                const auto wet = random.nextBool() ? SampleType (1) : static_cast<SampleType> (0.2 + 0.8 * random.nextDouble());
+                const auto tone = static_cast<SampleType> (random.nextDouble() * 2.0 - 1.0);
+
+                engine.setDrive (drive);
+                engine.setOutput (output);
+                engine.setMix (wet);
+                engine.setTone (tone);
+
+                reference.preGain.setTargetValue (juce::Decibels::decibelsToGain (drive));
+                reference.postGain.setTargetValue (juce::Decibels::decibelsToGain (output));
+                reference.mix.setTargetValue (wet);
+                reference.tilt.setTilt (tone);
+            }
+
+            const int numSamples = 1 + random.nextInt (maxBlock);
+            juce::AudioBuffer<SampleType> a (actual.getArrayOfWritePointers(), channels, numSamples);
+            juce::AudioBuffer<SampleType> e (expected.getArrayOfWritePointers(), channels, numSamples);
+
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                fillEdgeCase (a.getWritePointer (ch), numSamples, random);
+                e.copyFrom (ch, 0, a, ch, 0, numSamples);
+            }
+
+            const double inputPeak = getPeak (a) * juce::Decibels::decibelsToGain (static_cast<double> (TubeSaturation<SampleType>::maxDriveDb));
+
+            engine.process (a);
+            reference.process (e);
+            scale.update (juce::jmax (inputPeak, getPeak (e)), numSamples);
+
+            for (int ch = 0; ch < channels; ++ch)
+                compare (result, a.getReadPointer (ch), e.getReadPointer (ch), numSamples, scale.value);
+        }
+
+        return result;
+    }
+
+    int runVerification()
+    {
+        using SaturationKernels::Tier;
+
+        juce::Random random (0x7e5);
+        std::vector<CheckResult> results;
+
+        for (auto tier : { Tier::scalar, Tier::sse2, Tier::avx2, Tier::avx512, Tier::neon })
+        {
+            if (! SaturationKernels::isSupported (tier))
+                continue;
+
+            results.push_back (verifyShaperKernels (tier, random));
+
+            for (int channels : { 1, 2, 3, 6, 12 })
+            {
+                results.push_back (verifyTiltEQ<float> (channels, tier, random));
+                results.push_back (verifyEngine<float> (channels, tier, random));
+            }
+        }
+
+        for (int channels : { 1, 2, 3, 6, 12 })
+        {
+            results.push_back (verifyTiltEQ<double> (channels, Tier::automatic, random));
+            results.push_back (verifyEngine<double> (channels, Tier::automatic, random));
+        }
+
+        int failures = 0;
+
+        for (const auto& r : results)
+        {
+            std::cerr << (r.passed() ? "pass  " : "FAIL  ") << r.name << "  max error " << r.maxError
+                      << "  (" << juce::String (100.0 * r.worstRatio, 1) << "% of bound)" << std::endl;
+
+            if (! r.passed())
+                ++failures;
+        }
+
+        std::cerr << results.size() - static_cast<size_t> (failures) << " of " << results.size() << " checks passed" << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+
+    //==========================================================================
+    juce::var makeContext (const Options& options)
+    {
+        auto* context = new juce::DynamicObject();
+        context->setProperty ("date", juce::Time::getCurrentTime().toISO8601 (true));
+        context->setProperty ("host_name", juce::SystemStats::getComputerName());
+        context->setProperty ("executable", juce::File::getSpecialLocation (juce::File::currentExecutableFile).getFullPathName());
+        context->setProperty ("cpu_model", juce::SystemStats::getCpuModel());
+        context->setProperty ("num_cpus", juce::SystemStats::getNumCpus());
+        context->setProperty ("mhz_per_cpu", juce::SystemStats::getCpuSpeedInMegahertz());
+        context->setProperty ("kernel_tier", SaturationKernels::getTierName (SaturationKernels::getTable (options.tier).tier));
+       #if JUCE_DEBUG
+        context->setProperty ("library_build_type", "debug");
+       #else
+        context->setProperty ("library_build_type", "release");
+       #endif
+        return juce::var (context);
+    }
+
+    Options parseOptions (const juce::ArgumentList& args)
+    {
+        Options options;
+
+        if (args.containsOption ("--out"))
+            options.output = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--out"));
+
+        if (args.containsOption ("--seconds"))
+            options.seconds = juce::jmax (0.01, args.getValueForOption ("--seconds").getDoubleValue());
+
+        if (args.containsOption ("--repetitions"))
+            options.repetitions = juce::jmax (1, args.getValueForOption ("--repetitions").getIntValue());
+
+        if (args.containsOption ("--tier"))
+            options.tier = SaturationKernels::getTierFromName (args.getValueForOption ("--tier").toRawUTF8());
+
+        options.filter = args.getValueForOption ("--filter");
+        return options;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    const juce::ArgumentList args (argc, argv);
+    const auto options = parseOptions (args);
+    const juce::ScopedNoDenormals noDenormals;
+
+    if (args.containsOption ("--verify"))
+        return runVerification();
+
+    juce::Array<juce::var> results;
+
+    auto wanted = [&] (const juce::String& name)
+    {
+        return options.filter.isEmpty() || name.contains (options.filter);
+    };
+
+    auto add = [&] (const juce::var& result)
+    {
+        report (result);
+        results.add (result);
+    };
+
+    for (auto sampleRate : sampleRates)
+    {
+        for (auto channels : channelCounts)
+        {
+            const auto input = makeInput (sampleRate, channels);
+
+            for (auto blockSize : blockSizes)
+            {
+                const juce::String prefix = "/sr:" + juce::String (static_cast<int> (sampleRate))
+                                          + "/block:" + juce::String (blockSize)
+                                          + "/ch:" + juce::String (channels);
+
+                for (auto drive : driveLevels)
+                {
+                    for (auto mix : mixLevels)
+                    {
+                        const juce::String name = "TubeSaturation" + prefix
+                                                + "/drive:" + juce::String (static_cast<int> (drive))
+                                                + "/mix:" + getMixName (mix);
+
+                        if (wanted (name))
+                            add (benchmarkTubeSaturation ({ sampleRate, blockSize, channels, drive, mix },
+                                                          rationalShaper, input, options, name));
+                    }
+                }
+
+                const juce::String name = "TiltEQ.processSample" + prefix;
+
+                if (wanted (name))
+                    add (benchmarkTiltEQ ({ sampleRate, blockSize, channels, 0.0f, 1.0f }, input, options, name));
+            }
+        }
+    }
+
+    {
+        const Case typical { 48000.0, 512, 2, 0.0f, 1.0f };
+        const auto input = makeInput (typical.sampleRate, typical.channels);
+
+        for (auto drive : driveLevels)
+        {
+            for (const auto& shaper : shapers)
+            {
+                const juce::String name = juce::String ("TubeSaturation.shaper/mode:") + shaper.name
+                                        + "/sr:48000/block:512/ch:2/drive:" + juce::String (static_cast<int> (drive));
+
+                auto c = typical;
+                c.driveDb = drive;
+
+                if (wanted (name))
+                    add (benchmarkTubeSaturation (c, shaper, input, options, name));
+            }
+        }
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty ("context", makeContext (options));
+    root->setProperty ("benchmarks", results);
+
+    const auto json = juce::JSON::toString (juce::var (root));
+
+    if (options.output == juce::File())
+    {
+        std::cout << json << std::endl;
+    }
+    else if (! options.output.replaceWithText (json))
+    {
+        std::cerr << "Could not write " << options.output.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,329 @@
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "RealtimeInterceptors.h"
+
+#include <iostream>
+
+//==============================================================================
+// Real-time safety check
+//
+// Drives WarmSaturationProcessor::processBlock() the way a host would, with
+// randomised parameters, block sizes, bus layouts, precision and offline
+// state, and fails as soon as any block allocates, frees or locks a mutex.
+//
+// Built with -DWARMSAT_RTSAN=ON (clang 20 or later) the block runs inside a
+// [[clang::nonblocking]] function under -fsanitize=realtime, and the
+// sanitizer reports the violation with a stack trace and stops the run.
+// Otherwise RealtimeInterceptors catches allocations everywhere and, on
+// glibc, mutex locks too.
+//
+// Parameter changes are made both between blocks, as from the message
+// thread, and inside the checked region just before processBlock(), as
+// host automation arrives on the audio thread (the parameter listener and
+// the snapshot publish then run there too, and only JUCE's own listener
+// locks on that path are let through). prepareToPlay() and layout
+// changes run outside the checked region, since hosts never call them on
+// the audio thread. A listener stands in for the host wrapper, so anything
+// processBlock() reports to the host (JUCE calls listeners under a lock)
+// is caught too. Oversampling and shaper are automated to move the
+// latency, and the processor's message-thread side runs between
+// blocks; the check fails if no latency change ever reached the listener
+// that way. Some sessions run with the CPU meter's block timing on, and
+// the editor's side of it drains the timings between blocks.
+//
+//   RealtimeCheck [--iterations=200] [--seed=1] [--abort]
+//==============================================================================
+#if defined (__has_feature)
+ #if __has_feature (realtime_sanitizer)
+  #define WARMSAT_HAS_RTSAN 1
+ #endif
+#endif
+
+#ifndef WARMSAT_HAS_RTSAN
+ #define WARMSAT_HAS_RTSAN 0
+#endif
+
+#if WARMSAT_HAS_RTSAN
+ #define WARMSAT_NONBLOCKING [[clang::nonblocking]]
+#else
+ #define WARMSAT_NONBLOCKING
+#endif
+
+namespace
+{
+    // Only counts changes reported between blocks; prepareToPlay()
+    // reports latency as well, but that is not the path being checked
+    struct HostListener : juce::AudioProcessorListener
+    {
+        void audioProcessorParameterChanged (juce::AudioProcessor*, int, float) override {}
+
+        void audioProcessorChanged (juce::AudioProcessor*, const ChangeDetails& details) override
+        {
+            if (details.latencyChanged && betweenBlocks)
+                ++latencyChanges;
+        }
+
+        bool betweenBlocks = false;
+        int latencyChanges = 0;
+    };
+
+    struct Session
+    {
+        juce::AudioChannelSet layout;
+        double sampleRate = 48000.0;
+        int maximumBlockSize = 512;
+        bool doublePrecision = false;
+    };
+
+    juce::String describe (const Session& session)
+    {
+        return session.layout.getDescription()
+             + ", " + juce::String (session.sampleRate, 0) + " Hz"
+             + ", max block " + juce::String (session.maximumBlockSize)
+             + (session.doublePrecision ? ", double" : ", float");
+    }
+
+    Session makeSession (juce::Random& random)
+    {
+        const juce::AudioChannelSet layouts[] = { juce::AudioChannelSet::mono(),
+                                                  juce::AudioChannelSet::stereo(),
+                                                  juce::AudioChannelSet::createLCR(),
+                                                  juce::AudioChannelSet::create5point1(),
+                                                  juce::AudioChannelSet::create7point1(),
+                                                  juce::AudioChannelSet::create7point1point4() };
+        const double sampleRates[] = { 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 };
+        const int blockSizes[]     = { 32, 64, 128, 256, 441, 512, 1024, 2048, 4096 };
+
+        Session session;
+        session.layout = layouts[random.nextInt (juce::numElementsInArray (layouts))];
+        session.sampleRate = sampleRates[random.nextInt (juce::numElementsInArray (sampleRates))];
+        session.maximumBlockSize = blockSizes[random.nextInt (juce::numElementsInArray (blockSizes))];
+        session.doublePrecision = random.nextBool();
+        return session;
+    }
+
+    void randomiseParameters (juce::AudioProcessor& processor, juce::Random& random)
+    {
+        for (auto* parameter : processor.getParameters())
+            if (random.nextInt (3) == 0)
+                parameter->setValueNotifyingHost (random.nextFloat());
+    }
+
+    // The parameters that change the latency
+    void automateLatency (WarmSaturationProcessor& processor, juce::Random& random)
+    {
+        for (auto* id : { "oversampling", "osfilter", "shaper" })
+            if (auto* parameter = processor.apvts.getParameter (id))
+                parameter->setValueNotifyingHost (random.nextFloat());
+    }
+
+    template <typename SampleType>
+    void fillInput (juce::AudioBuffer<SampleType>& buffer, juce::Random& random)
+    {
+        // Silence now and then, so the engine's idle path is covered too
+        if (random.nextInt (8) == 0)
+        {
+            buffer.clear();
+            return;
+        }
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer (ch);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = static_cast<SampleType> (random.nextFloat() * 2.0f - 1.0f);
+        }
+    }
+
+    // What the host does on the audio thread before handing over the block
+    struct Automation
+    {
+        bool parameters = false;
+        bool latency = false;
+    };
+
+    template <typename SampleType>
+    void processRealtime (WarmSaturationProcessor& processor, juce::AudioBuffer<SampleType>& buffer,
+                          juce::MidiBuffer& midi, Automation automation, juce::Random& random) WARMSAT_NONBLOCKING
+    {
+        const RealtimeInterceptors::ScopedRealtime realtime;
+
+        // JUCE notifies parameter listeners under its own listener locks,
+        // as do its plug-in wrappers when they deliver automation; those
+        // are the host's locks, so only allocations count in here. The
+        // snapshot publish it ends in is lock-free by construction.
+        if (automation.parameters || automation.latency)
+        {
+            const RealtimeInterceptors::ScopedHostCall hostCall;
+
+            if (automation.parameters)
+                randomiseParameters (processor, random);
+
+            if (automation.latency)
+                automateLatency (processor, random);
+        }
+
+        processor.processBlock (buffer, midi);
+    }
+
+    // Returns the number of violations seen; processes ~blocksPerSession blocks
+    template <typename SampleType>
+    int runSession (WarmSaturationProcessor& processor, HostListener& host, const Session& session,
+                    juce::Random& random, int blocksPerSession)
+    {
+        const int channels = session.layout.size();
+
+        // The buffer is sized for the largest block up front: hosts own
+        // this memory, it is not the plug-in's to allocate
+        const int largestBlock = session.maximumBlockSize * 2;
+        juce::AudioBuffer<SampleType> storage (channels, largestBlock);
+        juce::MidiBuffer midi;
+
+        for (int block = 0; block < blocksPerSession; ++block)
+        {
+            // Mostly within the announced size, some partial blocks, and
+            // the occasional host that sends more than it announced
+            int numSamples = session.maximumBlockSize;
+            switch (random.nextInt (4))
+            {
+                case 0:  numSamples = 1 + random.nextInt (session.maximumBlockSize); break;
+                case 1:  numSamples = session.maximumBlockSize + 1 + random.nextInt (session.maximumBlockSize); break;
+                default: break;
+            }
+
+            // Half the automation comes from the audio thread itself
+            Automation automation;
+
+            if (random.nextInt (4) == 0)
+            {
+                if (random.nextBool())
+                    automation.parameters = true;
+                else
+                    randomiseParameters (processor, random);
+            }
+
+            if (random.nextInt (4) == 0)
+            {
+                if (random.nextBool())
+                    automation.latency = true;
+                else
+                    automateLatency (processor, random);
+            }
+
+            if (random.nextInt (16) == 0)
+                processor.setNonRealtime (! processor.isNonRealtime());
+
+            juce::AudioBuffer<SampleType> buffer (storage.getArrayOfWritePointers(), channels, numSamples);
+            fillInput (buffer, random);
+
+            RealtimeInterceptors::resetCounts();
+            processRealtime (processor, buffer, midi, automation, random);
+
+            // The message thread's turn, outside the checked region
+            host.betweenBlocks = true;
+            processor.buildRequestedOversamplers();
+            processor.updateHostLatency();
+            host.betweenBlocks = false;
+
+            WarmSaturationProcessor::BlockTiming timing;
+            while (processor.popBlockTiming (timing)) {}
+
+            int violations = 0;
+            for (int v = 0; v < RealtimeInterceptors::numViolations; ++v)
+            {
+                const auto kind = static_cast<RealtimeInterceptors::Violation> (v);
+                const int count = RealtimeInterceptors::getCount (kind);
+
+                if (count > 0)
+                    std::cerr << "  " << count << " x " << RealtimeInterceptors::getName (kind)
+                              << " in a block of " << numSamples << std::endl;
+
+                violations += count;
+            }
+
+            if (violations > 0)
+                return violations;
+        }
+
+        return 0;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList args (argc, argv);
+
+    const int iterations = args.containsOption ("--iterations")
+                             ? juce::jmax (1, args.getValueForOption ("--iterations").getIntValue())
+                             : 200;
+    const int seed = args.containsOption ("--seed") ? args.getValueForOption ("--seed").getIntValue() : 1;
+
+    RealtimeInterceptors::setAbortOnViolation (args.containsOption ("--abort"));
+
+   #if WARMSAT_HAS_RTSAN
+    std::cout << "Checking with RealtimeSanitizer" << std::endl;
+   #else
+    std::cout << "Checking allocations" << (RealtimeInterceptors::canInterceptLocks() ? " and mutex locks" : "")
+              << " (build with -DWARMSAT_RTSAN=ON for RealtimeSanitizer)" << std::endl;
+   #endif
+
+    WarmSaturationProcessor processor;
+    HostListener host;
+    processor.addListener (&host);
+    juce::Random random (seed);
+
+    for (int iteration = 0; iteration < iterations; ++iteration)
+    {
+        const auto session = makeSession (random);
+
+        // A layout or precision change, as a host would make it
+        processor.releaseResources();
+
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add (session.layout);
+        layout.outputBuses.add (session.layout);
+
+        if (! processor.setBusesLayout (layout))
+        {
+            std::cerr << "Layout rejected: " << describe (session) << std::endl;
+            return 1;
+        }
+
+        processor.setProcessingPrecision (session.doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                                  : juce::AudioProcessor::singlePrecision);
+        processor.setNonRealtime (random.nextInt (4) == 0);
+        processor.setTimingEnabled (random.nextBool());
+        randomiseParameters (processor, random);
+        processor.setRateAndBufferSizeDetails (session.sampleRate, session.maximumBlockSize);
+        processor.prepareToPlay (session.sampleRate, session.maximumBlockSize);
+
+        const int violations = session.doublePrecision
+                                 ? runSession<double> (processor, host, session, random, 64)
+                                 : runSession<float> (processor, host, session, random, 64);
+
+        if (violations > 0)
+        {
+            std::cerr << "FAILED: " << violations << " real-time violation(s) in session " << iteration
+                      << " (" << describe (session) << "), seed " << seed
+                      << ". Rerun with --abort under a debugger to see where." << std::endl;
+            return 1;
+        }
+    }
+
+    processor.removeListener (&host);
+
+    if (host.latencyChanges == 0)
+    {
+        std::cerr << "FAILED: no latency change reached the host listener, so reporting it was never checked"
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << "OK: " << iterations << " sessions, " << host.latencyChanges << " latency changes, "
+              << static_cast<int> (processor.getOversizedBlockCount()) << " oversized blocks split, "
+              << "no real-time violations" << std::endl;
+    return 0;
+}
@@ -0,0 +1,276 @@
+#include "RealtimeInterceptors.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#if defined (__has_feature)
+ #if __has_feature (realtime_sanitizer)
+  #define WARMSAT_HAS_RTSAN 1
+ #endif
+#endif
+
+#ifndef WARMSAT_HAS_RTSAN
+ #define WARMSAT_HAS_RTSAN 0
+#endif
+
+#if WARMSAT_HAS_RTSAN
+ #include <sanitizer/rtsan_interface.h>
+#endif
+
+#if ! WARMSAT_HAS_RTSAN && defined (__GLIBC__)
+ #define WARMSAT_INTERCEPT_LIBC 1
+ #include <dlfcn.h>
+ #include <malloc.h>
+ #include <pthread.h>
+#else
+ #define WARMSAT_INTERCEPT_LIBC 0
+#endif
+
+namespace
+{
+    // Constant-initialised, so safe to touch from the first allocation on
+    thread_local bool realtimeThread = false;
+    thread_local bool hostCall = false;
+
+    std::atomic<int> counts[RealtimeInterceptors::numViolations] {};
+    std::atomic<bool> abortOnViolation { false };
+
+    void note (RealtimeInterceptors::Violation violation) noexcept
+    {
+        if (! realtimeThread || (hostCall && violation == RealtimeInterceptors::lock))
+            return;
+
+        counts[violation].fetch_add (1, std::memory_order_relaxed);
+
+        if (abortOnViolation.load (std::memory_order_relaxed))
+            std::abort();
+    }
+}
+
+namespace RealtimeInterceptors
+{
+    ScopedRealtime::ScopedRealtime()  { realtimeThread = true; }
+    ScopedRealtime::~ScopedRealtime() { realtimeThread = false; }
+
+   #if WARMSAT_HAS_RTSAN
+    ScopedHostCall::ScopedHostCall()  { __rtsan_disable(); }
+    ScopedHostCall::~ScopedHostCall() { __rtsan_enable(); }
+   #else
+    ScopedHostCall::ScopedHostCall()  { hostCall = true; }
+    ScopedHostCall::~ScopedHostCall() { hostCall = false; }
+   #endif
+
+    int getCount (Violation violation)
+    {
+        return counts[violation].load (std::memory_order_relaxed);
+    }
+
+    void resetCounts()
+    {
+        for (auto& count : counts)
+            count.store (0, std::memory_order_relaxed);
+    }
+
+    const char* getName (Violation violation)
+    {
+        switch (violation)
+        {
+            case allocation:   return "allocation";
+            case deallocation: return "deallocation";
+            case lock:         return "mutex lock";
+            case numViolations:
+            default:           return "";
+        }
+    }
+
+    void setAbortOnViolation (bool shouldAbort)
+    {
+        abortOnViolation.store (shouldAbort, std::memory_order_relaxed);
+    }
+
+    bool canInterceptLocks()
+    {
+        return WARMSAT_INTERCEPT_LIBC != 0;
+    }
+}
+
+#if ! WARMSAT_HAS_RTSAN
+
+//==============================================================================
+// The C library entry points. On glibc malloc and friends are replaced too,
+// so operator new goes to glibc's own implementation directly and each
+// allocation is only counted once.
+#if WARMSAT_INTERCEPT_LIBC
+extern "C"
+{
+    void* __libc_malloc (size_t);
+    void* __libc_calloc (size_t, size_t);
+    void* __libc_realloc (void*, size_t);
+    void* __libc_memalign (size_t, size_t);
+    void  __libc_free (void*);
+}
+
+static void* rawAllocate (size_t size) noexcept  { return __libc_malloc (size); }
+static void  rawFree (void* p) noexcept          { __libc_free (p); }
+#else
+static void* rawAllocate (size_t size) noexcept  { return std::malloc (size); }
+static void  rawFree (void* p) noexcept          { std::free (p); }
+#endif
+
+// Over-allocates and keeps the block's start just before the aligned
+// pointer, which works with any allocator underneath
+static void* rawAllocateAligned (size_t size, size_t alignment) noexcept
+{
+    auto* block = static_cast<char*> (rawAllocate (size + alignment + sizeof (void*)));
+
+    if (block == nullptr)
+        return nullptr;
+
+    const auto start = reinterpret_cast<size_t> (block + sizeof (void*));
+    auto* aligned = reinterpret_cast<char*> ((start + alignment - 1) & ~(alignment - 1));
+    reinterpret_cast<void**> (aligned)[-1] = block;
+    return aligned;
+}
+
+static void rawFreeAligned (void* p) noexcept
+{
+    if (p != nullptr)
+        rawFree (static_cast<void**> (p)[-1]);
+}
+
+//==============================================================================
+static void* checkedNew (size_t size)
+{
+    note (RealtimeInterceptors::allocation);
+
+    if (auto* p = rawAllocate (size > 0 ? size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+static void* checkedNewAligned (size_t size, std::align_val_t alignment)
+{
+    note (RealtimeInterceptors::allocation);
+
+    if (auto* p = rawAllocateAligned (size > 0 ? size : 1, static_cast<size_t> (alignment)))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+static void checkedDelete (void* p) noexcept
+{
+    if (p == nullptr)
+        return;
+
+    note (RealtimeInterceptors::deallocation);
+    rawFree (p);
+}
+
+static void checkedDeleteAligned (void* p) noexcept
+{
+    if (p == nullptr)
+        return;
+
+    note (RealtimeInterceptors::deallocation);
+    rawFreeAligned (p);
+}
+
+void* operator new (size_t size)                                          { return checkedNew (size); }
+void* operator new[] (size_t size)                                        { return checkedNew (size); }
+void* operator new (size_t size, const std::nothrow_t&) noexcept          { try { return checkedNew (size); } catch (...) { return nullptr; } }
+void* operator new[] (size_t size, const std::nothrow_t&) noexcept        { try { return checkedNew (size); } catch (...) { return nullptr; } }
+void* operator new (size_t size, std::align_val_t a)                      { return checkedNewAligned (size, a); }
+void* operator new[] (size_t size, std::align_val_t a)                    { return checkedNewAligned (size, a); }
+void* operator new (size_t size, std::align_val_t a, const std::nothrow_t&) noexcept   { try { return checkedNewAligned (size, a); } catch (...) { return nullptr; } }
+void* operator new[] (size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { try { return checkedNewAligned (size, a); } catch (...) { return nullptr; } }
+
+void operator delete (void* p) noexcept                                   { checkedDelete (p); }
+void operator delete[] (void* p) noexcept                                 { checkedDelete (p); }
+void operator delete (void* p, size_t) noexcept                           { checkedDelete (p); }
+void operator delete[] (void* p, size_t) noexcept                         { checkedDelete (p); }
+void operator delete (void* p, const std::nothrow_t&) noexcept            { checkedDelete (p); }
+void operator delete[] (void* p, const std::nothrow_t&) noexcept          { checkedDelete (p); }
+void operator delete (void* p, std::align_val_t) noexcept                 { checkedDeleteAligned (p); }
+void operator delete[] (void* p, std::align_val_t) noexcept               { checkedDeleteAligned (p); }
+void operator delete (void* p, size_t, std::align_val_t) noexcept         { checkedDeleteAligned (p); }
+void operator delete[] (void* p, size_t, std::align_val_t) noexcept       { checkedDeleteAligned (p); }
+void operator delete (void* p, std::align_val_t, const std::nothrow_t&) noexcept   { checkedDeleteAligned (p); }
+void operator delete[] (void* p, std::align_val_t, const std::nothrow_t&) noexcept { checkedDeleteAligned (p); }
+
+//==============================================================================
+#if WARMSAT_INTERCEPT_LIBC
+extern "C"
+{
+    void* malloc (size_t size)
+    {
+        note (RealtimeInterceptors::allocation);
+        return __libc_malloc (size);
+    }
+
+    void* calloc (size_t count, size_t size)
+    {
+        note (RealtimeInterceptors::allocation);
+        return __libc_calloc (count, size);
+    }
+
+    void* realloc (void* p, size_t size)
+    {
+        note (RealtimeInterceptors::allocation);
+        return __libc_realloc (p, size);
+    }
+
+    void* memalign (size_t alignment, size_t size)
+    {
+        note (RealtimeInterceptors::allocation);
+        return __libc_memalign (alignment, size);
+    }
+
+    void* aligned_alloc (size_t alignment, size_t size)
+    {
+        note (RealtimeInterceptors::allocation);
+        return __libc_memalign (alignment, size);
+    }
+
+    int posix_memalign (void** result, size_t alignment, size_t size)
+    {
+        note (RealtimeInterceptors::allocation);
+        *result = __libc_memalign (alignment, size);
+        return *result != nullptr || size == 0 ? 0 : ENOMEM;
+    }
+
+    void free (void* p)
+    {
+        if (p != nullptr)
+            note (RealtimeInterceptors::deallocation);
+
+        __libc_free (p);
+    }
+
+    // glibc's own symbol is only reachable through the dynamic linker; it is
+    // looked up before main() so the lookup never runs on the audio thread
+    using MutexLock = int (*) (pthread_mutex_t*);
+
+    static MutexLock findMutexLock()
+    {
+        return reinterpret_cast<MutexLock> (dlsym (RTLD_NEXT, "pthread_mutex_lock"));
+    }
+
+    static MutexLock realMutexLock = findMutexLock();
+
+    int pthread_mutex_lock (pthread_mutex_t* mutex)
+    {
+        note (RealtimeInterceptors::lock);
+
+        if (realMutexLock == nullptr)
+            realMutexLock = findMutexLock();
+
+        return realMutexLock (mutex);
+    }
+}
+#endif
+
+#endif
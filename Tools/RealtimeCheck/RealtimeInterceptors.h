@@ -0,0 +1,55 @@
+#pragma once
+
+//==============================================================================
+// Allocation and lock interception for builds without RealtimeSanitizer
+//
+// RealtimeInterceptors.cpp replaces the global operator new/delete and, on
+// glibc, malloc and friends and pthread_mutex_lock. Calls made on a thread
+// while a ScopedRealtime is alive on it are counted as violations; every
+// other call goes straight through. Under -fsanitize=realtime none of this
+// is compiled, as the sanitizer intercepts the same functions itself.
+//==============================================================================
+namespace RealtimeInterceptors
+{
+    enum Violation
+    {
+        allocation,
+        deallocation,
+        lock,
+        numViolations
+    };
+
+    // Marks the current thread as real-time for its lifetime
+    struct ScopedRealtime
+    {
+        ScopedRealtime();
+        ~ScopedRealtime();
+
+        ScopedRealtime (const ScopedRealtime&) = delete;
+        ScopedRealtime& operator= (const ScopedRealtime&) = delete;
+    };
+
+    // Inside a ScopedRealtime, marks a call the host makes on the audio
+    // thread and whose locks are its own, e.g. JUCE's parameter listener
+    // notification: locks are let through, allocations still count. Under
+    // RealtimeSanitizer, which can't tell the two apart, it suspends
+    // checking altogether.
+    struct ScopedHostCall
+    {
+        ScopedHostCall();
+        ~ScopedHostCall();
+
+        ScopedHostCall (const ScopedHostCall&) = delete;
+        ScopedHostCall& operator= (const ScopedHostCall&) = delete;
+    };
+
+    int getCount (Violation violation);
+    void resetCounts();
+    const char* getName (Violation violation);
+
+    // Aborts at the offending call, so a debugger shows where it came from
+    void setAbortOnViolation (bool shouldAbort);
+
+    // Whether locks are seen too; allocations always are
+    bool canInterceptLocks();
+}